@@ -0,0 +1,112 @@
+#include <NatsMq>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace NatsMq;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Profile
+    {
+        const char*       name;
+        ConnectionOptions options;
+    };
+
+    //! Publish messages of the given size while a subscription counts them, returns received messages per second
+    double throughput(const Client::Urls& urls, const ConnectionOptions& options, size_t payloadSize, size_t count)
+    {
+        constexpr auto subject{ "benchmark.throughput" };
+
+        std::unique_ptr<Client> publisher(Client::create());
+        std::unique_ptr<Client> consumer(Client::create());
+        publisher->connect(urls, options);
+        consumer->connect(urls, options);
+
+        std::atomic<size_t>           received{ 0 };
+        std::unique_ptr<Subscription> sub(consumer->subscribe(subject, [&received](Message) { ++received; }));
+        consumer->flush();
+
+        const std::vector<uint8_t> payload(payloadSize, 'x');
+
+        const auto start = Clock::now();
+        for (size_t i = 0; i < count; ++i)
+            publisher->publish(subject, payload.data(), payload.size());
+        publisher->flush(10000);
+
+        const auto deadline = Clock::now() + std::chrono::seconds(30);
+        while (received < count && Clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return received / seconds;
+    }
+
+    //! Round trip of small requests, returns the median and the 99th percentile in microseconds
+    std::pair<int64_t, int64_t> latency(const Client::Urls& urls, const ConnectionOptions& options, size_t count)
+    {
+        constexpr auto subject{ "benchmark.latency" };
+
+        std::unique_ptr<Client> client(Client::create());
+        std::unique_ptr<Client> replier(Client::create());
+        client->connect(urls, options);
+        replier->connect(urls, options);
+
+        const auto& replierRef = *replier;
+
+        std::unique_ptr<Subscription> sub(replier->subscribe(subject, [&replierRef](Message msg) {
+            replierRef.publish(Message(msg.replySubject, msg.data));
+        }));
+        replier->flush();
+
+        std::vector<int64_t> samples;
+        samples.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto start = Clock::now();
+            client->request(Message(subject, "ping"));
+            samples.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+        }
+
+        std::sort(samples.begin(), samples.end());
+        return { samples[samples.size() / 2], samples[samples.size() * 99 / 100] };
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const Client::Urls urls{ argc > 1 ? argv[1] : "nats://localhost:4222" };
+
+    const std::vector<Profile> profiles{
+        { "default", ConnectionOptions{} },
+        { "lowLatency", ConnectionProfiles::lowLatency() },
+        { "highThroughput", ConnectionProfiles::highThroughput() },
+        { "largePayload", ConnectionProfiles::largePayload() },
+    };
+
+    try
+    {
+        for (auto&& profile : profiles)
+        {
+            const auto small      = throughput(urls, profile.options, 128, 1000000);
+            const auto large      = throughput(urls, profile.options, 1024 * 1024, 500);
+            const auto [p50, p99] = latency(urls, profile.options, 10000);
+
+            std::cout << profile.name << ": "
+                      << static_cast<int64_t>(small) << " msg/s (128 B), "
+                      << static_cast<int64_t>(large) << " msg/s (1 MB), "
+                      << "request p50 " << p50 << " us, p99 " << p99 << " us" << std::endl;
+        }
+    }
+    catch (const NatsMq::Exception& exc)
+    {
+        std::cout << exc.what();
+    }
+    return 0;
+}
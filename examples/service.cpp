@@ -0,0 +1,40 @@
+#include <NatsMq>
+#include <iostream>
+
+using namespace NatsMq;
+
+int main()
+{
+    std::unique_ptr<Client> client(Client::create());
+
+    try
+    {
+        client->connect({ "nats://172.20.73.29:4222" });
+
+        ServiceConfig config;
+        config.name        = "echo";
+        config.description = "Echo service example";
+        config.workers     = 4;
+
+        std::unique_ptr<Service> service(client->service(config));
+
+        service->addEndpoint("echo", [](Message msg) {
+            if (msg.data.empty())
+                throw ServiceError(400, "empty request");
+
+            return msg;
+        }, "example.echo");
+
+        auto reply = client->request(Message("example.echo", "it is service request data"));
+        std::cout << std::string(reply) << std::endl;
+
+        for (auto&& stats : service->statistics())
+            std::cout << stats.name << ": requests " << stats.requests << ", errors " << stats.errors << std::endl;
+    }
+    catch (const NatsMq::Exception& exc)
+    {
+        std::cout << exc.what();
+    }
+
+    return 0;
+}
@@ -2,19 +2,24 @@
 
 #include <future>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "Entities.h"
 #include "Export.h"
+#include "MessageView.h"
+#include "PublisherHandle.h"
+#include "Result.h"
 #include "Subscription.h"
 #include "SyncSubscription.h"
 
-// TODO cnatc managment: thread pool size and etc
-
 namespace NatsMq
 {
     class JetStream;
     class Connection;
+    class Service;
+    class Router;
+    class Subject;
 
     class NATSMQ_EXPORT Client
     {
@@ -25,6 +30,8 @@ namespace NatsMq
 
         Client(Connection*);
 
+        Client(std::shared_ptr<Connection> connection);
+
         ~Client();
 
         Client(const Client&);
@@ -50,15 +57,78 @@ namespace NatsMq
         //! Get connection statistics
         IOStatistic statistics() const;
 
+        //! Client of the control connection (see ConnectionOptions::controlLane), for sending through it explicitly.
+        //! Publishing, subscriptions and requests on the control lane subjects go through it automatically.
+        //! Returns this client if the control lane is disabled.
+        Client control() const;
+
         //! Publish message
         void publish(Message msg) const;
 
+        //! Publish raw bytes without headers. The data is passed directly to the connection, no intermediate Message is built.
+        void publish(std::string_view subject, const void* data, size_t size) const;
+
+        //! Same as publish(subject, data, size)
+        void publish(std::string_view subject, ByteSpan data) const;
+
+        //! Publish all messages and make one flush at the end. If flushTimeoutMs is negative, flush is not performed.
+        //! Errors of single messages are not thrown, a status for each message is returned. An exception is thrown only if flush failed.
+        //! Messages on the control lane subjects are sent through the control connection.
+        std::vector<Status> publishBatch(const std::vector<Message>& msgs, int64_t flushTimeoutMs = 2000) const;
+
+        //! Same as publishBatch(vector<Message>, flushTimeoutMs)
+        std::vector<Status> publishBatch(const Message* msgs, size_t count, int64_t flushTimeoutMs = 2000) const;
+
+        //! Same as publishBatch(vector<Message>, flushTimeoutMs), but messages are not copied and have no headers
+        std::vector<Status> publishBatch(const std::vector<RawMessage>& msgs, int64_t flushTimeoutMs = 2000) const;
+
+        //! Same as publishBatch(vector<RawMessage>, flushTimeoutMs)
+        std::vector<Status> publishBatch(const RawMessage* msgs, size_t count, int64_t flushTimeoutMs = 2000) const;
+
+        //! Send all buffered data to the server and wait until it is processed
+        void flush(int64_t timeoutMs = 2000) const;
+
+        //! Hold all messages published through the client (and its publisher handles) until uncork() is called.
+        //! Messages are copied while the client is corked.
+        void cork() const;
+
+        //! Publish all held messages in order and stop holding new ones. Returns a status for each held message.
+        std::vector<Status> uncork() const;
+
+        //! Create publisher bound to the subject. The subject is validated once, an exception is thrown if it is invalid.
+        //! Use it for publishing many messages to a few fixed subjects.
+        PublisherHandle* publisher(const std::string& subject) const;
+
+        //! Same as publisher(string), but the subject is already validated. Patterns are rejected.
+        PublisherHandle* publisher(const Subject& subject) const;
+
         //! Request data. Request data. If there is no responder, an exception will be thrown
         Message request(Message msg, uint64_t timeoutMs = 2000) const;
 
+        //! Same as request, but a hedge copy is sent if the reply is late and the request is retried on NoResponders or Timeout
+        //! according to the policy. All attempts share the timeout.
+        Message request(const Message& msg, uint64_t timeoutMs, const RequestPolicy& policy) const;
+
         //! Same as request but async
         std::future<Message> arequest(Message msg, uint64_t timeoutMs = 2000) const;
 
+        //! Same as request but the callback is invoked with the reply (or the failure status) on the delivery thread.
+        //! Timeouts are reported from the internal timer thread. The callback must not block.
+        void request(Message msg, uint64_t timeoutMs, RequestCb cb) const;
+
+        //! Send all requests and invoke the callback once, when every request got a reply or failed.
+        //! Results are in the same order as the requests. Requests on the control lane subjects are sent through the control connection.
+        void requestBatch(std::vector<Message> msgs, uint64_t timeoutMs, RequestBatchCb cb) const;
+
+        //! Publish the request once and collect all replies received before the timeout expires.
+        //! Stops earlier when maxReplies replies are received, zero means no limit.
+        //! If there is no responder, an exception will be thrown
+        std::vector<Message> requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs = 2000) const;
+
+        //! Same as requestMany, but each reply is passed to the callback as soon as it arrives.
+        //! The callback is invoked on the calling thread, return false to stop waiting for more replies.
+        void requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs, RequestManyCb cb) const;
+
         //! Create subscribtion
         Subscription* subscribe(const std::string& subject, SubscriptionCb cb) const;
 
@@ -74,24 +144,63 @@ namespace NatsMq
         //! If no message is received by the given timeout (in milliseconds), the message handler is invoked with a empty message.
         Subscription* subscribe(const std::string& subject, const std::string& queueGroup, int64_t timeoutMs, SubscriptionCb cb) const;
 
+        //! Create subscribtion with the callback invoked according to the delivery options (connection thread, dedicated thread or executor).
+        //! Empty queue group creates a regular subscribtion. The global delivery pool is configured with Runtime::configure().
+        Subscription* subscribe(const std::string& subject, const std::string& queueGroup, const DeliveryOptions& delivery, SubscriptionCb cb) const;
+
+        //! Create subscribtion that passes messages to the callback in batches: when maxBatch messages are collected
+        //! or maxLatencyMs has passed since the first message of the batch. Messages still collected are passed on destruction.
+        //! The vector is reused between calls, move the messages out to keep them.
+        //! An exception thrown by the callback is reported to the error callbacks, the batch is dropped and delivery goes on.
+        Subscription* subscribeBatch(const std::string& subject, size_t maxBatch, uint64_t maxLatencyMs, SubscriptionBatchCb cb) const;
+
+        //! Create subscribtion with zero-copy delivery. The view borrows the underlying message and is valid only inside the callback.
+        //! A separate name is used because a generic lambda cannot be matched against both SubscriptionCb and SubscriptionViewCb.
+        Subscription* subscribeView(const std::string& subject, SubscriptionViewCb cb) const;
+
+        //! Same as subscribeView(subject, callback), but creates queue subscribtion
+        Subscription* subscribeView(const std::string& subject, const std::string& queueGroup, SubscriptionViewCb cb) const;
+
+        //! Create one subscription on the subject (usually a wildcard) and dispatch its messages to local handlers by subject pattern.
+        //! Empty queue group creates a regular subscribtion.
+        Router* router(const std::string& subject, const std::string& queueGroup = {}, const DeliveryOptions& delivery = {}) const;
+
         //! Create a synchronous subscription that can be polled via call next() for message recive
         SyncSubscription* syncSubscribe(const std::string& subject, const std::string& queueGroup = {}) const;
 
+        //! Create request/reply service. Endpoints are added to the returned object.
+        Service* service(const ServiceConfig& config) const;
+
         //! Create jetstream
         JetStream* jetstream(const Js::Options& options = {}) const;
 
-        //! Called all times when connection status changed
+        //! Called all times when connection status changed. Returns a handle for unregisterConnectionCallback().
+        //! Callbacks can be registered and removed from any thread, including from a callback.
+        //! Only state changes of this client's own connection are reported, register on control() to follow the control connection.
         int registerConnectionCallback(ConnectionStateCb);
 
-        //! Remove registred callback
+        //! Remove registred callback. Handles of other callbacks stay valid.
         void unregisterConnectionCallback(int idx) const;
 
-        //! Called all times when error occured
+        //! Called all times when error occured. Returns a handle for unregisterErrorCallback().
+        //! The client and its control() client share error and error report callbacks, they receive the errors of both connections.
         int registerErrorCallback(ErrorCb);
 
-        //! Remove registred callback
+        //! Remove registred callback. Handles of other callbacks stay valid.
         void unregisterErrorCallback(int idx) const;
 
+        //! Called for errors with the subscription context. If ConnectionOptions::errorReports is set,
+        //! errors are coalesced per subscription and status and reported (to error callbacks too) once per window.
+        //! Returns a handle for unregisterErrorReportCallback().
+        int registerErrorReportCallback(ErrorReportCb);
+
+        //! Remove registred callback. Handles of other callbacks stay valid.
+        void unregisterErrorReportCallback(int idx) const;
+
+    private:
+        //! Control connection for the control lane subjects, otherwise the main one
+        Connection& lane(std::string_view subject) const;
+
     private:
         std::shared_ptr<Connection> _connection;
     };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Client.h"
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    class ClientPoolPrivate;
+
+    //! Several connections to the same servers. Each connection has its own socket, read loop and flusher,
+    //! so the pool is not limited by the throughput of one socket. Publishing, subscriptions and requests
+    //! are spread over the connections according to the routing.
+    class NATSMQ_EXPORT ClientPool
+    {
+    public:
+        static ClientPool* create(size_t connections, PoolRouting routing = PoolRouting::SubjectHash);
+
+        ClientPool(ClientPoolPrivate*);
+
+        ~ClientPool();
+
+        ClientPool(ClientPool&&);
+
+        ClientPool& operator=(ClientPool&&);
+
+        //! Connect all connections to hosts
+        void connect(const Client::Urls& hosts, const ConnectionOptions& options = {}) const;
+
+        //! Disconnect all connections
+        void disconnect() const;
+
+        //! Number of connections
+        size_t size() const noexcept;
+
+        //! Client of the connection by index
+        const Client& client(size_t index) const;
+
+        //! Client selected by the routing for the subject
+        const Client& clientFor(std::string_view subject) const;
+
+        //! Sum of statistics of all connections
+        IOStatistic statistics() const;
+
+        //! Publish message
+        void publish(Message msg) const;
+
+        //! Publish raw bytes without headers
+        void publish(std::string_view subject, const void* data, size_t size) const;
+
+        //! Same as publish(subject, data, size)
+        void publish(std::string_view subject, ByteSpan data) const;
+
+        //! Flush all connections
+        void flush(int64_t timeoutMs = 2000) const;
+
+        //! Request data. If there is no responder, an exception will be thrown
+        Message request(Message msg, uint64_t timeoutMs = 2000) const;
+
+        //! Same as request but async
+        std::future<Message> arequest(Message msg, uint64_t timeoutMs = 2000) const;
+
+        //! Create subscribtion on the connection selected for the subject. Messages published through any connection of the pool are received.
+        Subscription* subscribe(const std::string& subject, SubscriptionCb cb) const;
+
+        //! Create queue subscribtion on the connection selected for the subject
+        Subscription* subscribe(const std::string& subject, const std::string& queueGroup, SubscriptionCb cb) const;
+
+    private:
+        std::unique_ptr<ClientPoolPrivate> _impl;
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    //! Connection options tuned for typical workloads. The IO buffers, buffering of publications, pending limits,
+    //! reconnect buffer and ping interval are set together. Change the other fields (name, credentials, ...) on the result.
+    namespace ConnectionProfiles
+    {
+        //! Small messages, request/reply. Every publication is sent right away, a dead connection is detected in seconds.
+        NATSMQ_EXPORT ConnectionOptions lowLatency();
+
+        //! Streams of small and medium messages. Large buffers and adaptive flushing, deep pending queues.
+        NATSMQ_EXPORT ConnectionOptions highThroughput();
+
+        //! Messages of hundreds of kilobytes and more. Large buffers, pending limits in bytes rather than in messages.
+        NATSMQ_EXPORT ConnectionOptions largePayload();
+    }
+}
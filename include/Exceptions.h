@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
 
 #include "Entities.h"
 #include "Export.h"
@@ -32,4 +33,12 @@ namespace NatsMq
 
         Js::Status jsError;
     };
+
+    //! Throw from a service endpoint handler to reply with the error code and description
+    struct NATSMQ_EXPORT ServiceError : public std::runtime_error
+    {
+        ServiceError(int code, const std::string& description);
+
+        int code;
+    };
 }
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <functional>
+
+#include "Export.h"
+
+namespace NatsMq
+{
+    //! Runs subscription callbacks on user threads. Implementations must be thread-safe:
+    //! execute() is called from the library delivery threads.
+    class NATSMQ_EXPORT Executor
+    {
+    public:
+        using Task = std::function<void()>;
+
+        virtual ~Executor() = default;
+
+        virtual void execute(Task task) = 0;
+    };
+}
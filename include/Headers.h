@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Export.h"
+
+namespace NatsMq
+{
+    //! Compact message headers container. All keys and values are stored in one contiguous buffer,
+    //! fields are described by a small offset table. A key can hold several values, lookup is case-insensitive.
+    //! Received headers are copied from cnats on receive, use MessageView to read headers without a copy.
+    class NATSMQ_EXPORT Headers
+    {
+    public:
+        using Field = std::pair<std::string_view, std::string_view>;
+
+        class const_iterator
+        {
+        public:
+            using value_type        = Field;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = Field;
+            using iterator_category = std::forward_iterator_tag;
+
+            const_iterator(const Headers* headers, size_t idx);
+
+            Field operator*() const;
+
+            const_iterator& operator++();
+
+            const_iterator operator++(int);
+
+            bool operator==(const const_iterator& other) const noexcept;
+
+            bool operator!=(const const_iterator& other) const noexcept;
+
+        private:
+            const Headers* _headers;
+            size_t         _idx;
+        };
+
+        Headers() = default;
+
+        Headers(std::initializer_list<std::pair<std::string, std::string>> fields);
+
+        //! Get first value of the key, empty if key does not exist
+        std::string_view get(std::string_view key) const;
+
+        //! Get all values of the key
+        std::vector<std::string_view> values(std::string_view key) const;
+
+        //! Check key existence
+        bool contains(std::string_view key) const;
+
+        //! Append value to the key
+        void add(std::string_view key, std::string_view value);
+
+        //! Replace all values of the key
+        void set(std::string_view key, std::string_view value);
+
+        //! Remove all values of the key
+        void remove(std::string_view key);
+
+        //! Remove all fields
+        void clear() noexcept;
+
+        //! Number of fields (a key with several values counts several times)
+        size_t size() const;
+
+        bool empty() const;
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+        //! Order-insensitive comparison of fields
+        bool operator==(const Headers& other) const;
+
+        bool operator!=(const Headers& other) const;
+
+    private:
+        struct Entry
+        {
+            uint32_t keyOffset;
+            uint32_t keyLength;
+            uint32_t valueOffset;
+            uint32_t valueLength;
+        };
+
+        Entry append(std::string_view key, std::string_view value);
+
+        Field field(const Entry& entry) const noexcept;
+
+        void compact();
+
+    private:
+        std::string        _buffer;
+        std::vector<Entry> _entries;
+    };
+}
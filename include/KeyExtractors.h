@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    //! Ready-made keys for the KeyOrdered delivery
+    namespace KeyExtractors
+    {
+        //! Token of the message subject, a negative index counts from the end. Empty key if there is no such token.
+        NATSMQ_EXPORT KeyExtractor subjectToken(int index);
+
+        //! First value of the message header. Empty key if there is no such header.
+        NATSMQ_EXPORT KeyExtractor header(std::string name);
+    }
+}
@@ -1,16 +1,16 @@
 #pragma once
-#include <map>
 #include <memory>
 #include <vector>
 
 #include "Entities.h"
 #include "Export.h"
+#include "Headers.h"
 
 namespace NatsMq
 {
     struct Message
     {
-        using Headers = std::map<std::string, std::string>;
+        using Headers = NatsMq::Headers;
 
         Message() = default;
 
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    class MessageViewPrivate;
+
+    //! Non-owning view of a delivered message. Subject, reply and payload point directly into the cnats message,
+    //! so the view (and everything obtained from it) is valid only inside the subscription callback.
+    //! Use toMessage() to keep a copy after the callback returns.
+    class NATSMQ_EXPORT MessageView
+    {
+    public:
+        MessageView(const MessageViewPrivate* impl);
+
+        //! Main message subject
+        std::string_view subject() const noexcept;
+
+        //! Subject for reply on request
+        std::string_view replySubject() const noexcept;
+
+        //! Raw data
+        ByteSpan data() const noexcept;
+
+        operator std::string_view() const noexcept;
+
+        //! Check if the message is empty (for example, timeout of a temporary subscription)
+        bool isEmpty() const noexcept;
+
+        //! Get first value of the header. Headers are parsed by cnats only on first access.
+        //! If the header is absent, an empty view is returned.
+        std::string_view header(const std::string& key) const;
+
+        //! Get all values of the header
+        std::vector<std::string_view> headerValues(const std::string& key) const;
+
+        //! Get all header keys
+        std::vector<std::string_view> headerKeys() const;
+
+        //! Make an owning copy of the message
+        Message toMessage() const;
+
+    private:
+        const MessageViewPrivate* _impl;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    class Headers;
+    class PublisherHandlePrivate;
+
+    //! Publisher bound to a subject. The subject is validated and prepared once, when the handle is created,
+    //! so publishing in a hot loop skips the per-call subject handling and Message construction.
+    class NATSMQ_EXPORT PublisherHandle
+    {
+    public:
+        PublisherHandle(PublisherHandlePrivate* impl);
+
+        ~PublisherHandle();
+
+        PublisherHandle(PublisherHandle&&);
+
+        PublisherHandle& operator=(PublisherHandle&&);
+
+        //! Get bound subject
+        std::string subject() const noexcept;
+
+        //! Publish raw bytes to the bound subject
+        void publish(const void* data, size_t size) const;
+
+        //! Same as publish(data, size)
+        void publish(ByteSpan data) const;
+
+        //! Publish raw bytes with headers to the bound subject
+        void publish(ByteSpan data, const Headers& headers) const;
+
+        //! Publish raw bytes to the "<bound subject>.<suffix>" subject. Only the suffix is validated.
+        void publish(std::string_view suffix, ByteSpan data) const;
+
+    private:
+        std::unique_ptr<PublisherHandlePrivate> _impl;
+    };
+}
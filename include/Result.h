@@ -0,0 +1,56 @@
+#pragma once
+
+#include <optional>
+#include <utility>
+
+#include "Entities.h"
+#include "Exceptions.h"
+
+namespace NatsMq
+{
+    //! Value of an operation or the status it failed with
+    template <typename T>
+    class Result
+    {
+    public:
+        Result(T value)
+            : _status(Status::Ok)
+            , _value(std::move(value))
+        {
+        }
+
+        Result(Status status)
+            : _status(status)
+        {
+        }
+
+        bool ok() const noexcept { return _status == Status::Ok; }
+
+        explicit operator bool() const noexcept { return ok(); }
+
+        Status status() const noexcept { return _status; }
+
+        //! Get the value. Exception with the status is thrown if the operation failed
+        const T& value() const&
+        {
+            exceptionIfError(_status);
+            return *_value;
+        }
+
+        T& value() &
+        {
+            exceptionIfError(_status);
+            return *_value;
+        }
+
+        T&& value() &&
+        {
+            exceptionIfError(_status);
+            return std::move(*_value);
+        }
+
+    private:
+        Status           _status;
+        std::optional<T> _value;
+    };
+}
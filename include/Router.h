@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    class RouterPrivate;
+    class Subject;
+
+    //! Dispatches messages of one wildcard subscription to local handlers by subject pattern.
+    //! Thousands of handlers cost one server subscription, the lookup is done by a token trie.
+    //! Handlers can be added and removed from any thread, including from a handler.
+    class NATSMQ_EXPORT Router
+    {
+    public:
+        Router(RouterPrivate*);
+
+        ~Router();
+
+        Router(Router&&);
+
+        Router& operator=(Router&&);
+
+        //! Add handler of the pattern, wildcards are allowed. The pattern should be covered by the router subject,
+        //! otherwise the handler is never invoked. Returns id of the handler for remove().
+        //! A message matching several patterns is passed to each of their handlers.
+        uint64_t add(const std::string& pattern, SubscriptionCb cb);
+
+        //! Same as add(string, callback), but the pattern is already validated
+        uint64_t add(const Subject& pattern, SubscriptionCb cb);
+
+        //! Remove handler. The handler can still be running on the delivery thread when the call returns.
+        void remove(uint64_t id);
+
+        //! Number of handlers
+        size_t size() const;
+
+        //! Number of messages that did not match any handler
+        uint64_t unmatched() const noexcept;
+
+        //! Statistics of the underlying subscription
+        SubscriptionStatistic statistics() const;
+
+    private:
+        std::unique_ptr<RouterPrivate> _impl;
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    //! Library-wide settings shared by all clients
+    class NATSMQ_EXPORT Runtime
+    {
+    public:
+        //! Apply the configuration. The global delivery pool can only grow, a smaller size is ignored.
+        static void configure(const RuntimeConfig& config);
+
+        //! Current configuration
+        static RuntimeConfig config();
+
+        //! Queue depth of every subscription with Dedicated or Executor delivery
+        static std::vector<DeliveryStatistic> deliveryStatistics();
+    };
+}
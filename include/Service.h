@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Entities.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    class ServicePrivate;
+
+    //! Request/reply service. Endpoints are queue subscriptions, handlers are executed by the service worker pool,
+    //! so a slow handler does not block the delivery thread. The service answers the discovery requests on
+    //! $SRV.PING, $SRV.INFO and $SRV.STATS subjects (also with the name and name.id suffixes).
+    class NATSMQ_EXPORT Service
+    {
+    public:
+        Service(ServicePrivate*);
+
+        ~Service();
+
+        Service(Service&&);
+
+        Service& operator=(Service&&);
+
+        //! Add endpoint. If the subject is empty, the endpoint name is used as the subject.
+        //! The message returned by the handler is sent as the reply, its subject is ignored.
+        //! Throw ServiceError from the handler to reply with an error.
+        void addEndpoint(const std::string& name, ServiceHandler handler, const std::string& subject = {});
+
+        //! Unique id of the service instance
+        std::string id() const;
+
+        std::string name() const;
+
+        //! Statistics of all endpoints
+        std::vector<EndpointStatistic> statistics() const;
+
+        void resetStatistics();
+
+        //! Stop receiving requests and wait until the accepted ones are handled
+        void stop();
+
+    private:
+        std::unique_ptr<ServicePrivate> _impl;
+    };
+}
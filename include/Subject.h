@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "Export.h"
+
+namespace NatsMq
+{
+    //! Subject helpers working on views, nothing is allocated or split into strings.
+    //! Everything is constexpr, at runtime the token search and comparison are done by memchr and memcmp.
+    namespace Subjects
+    {
+        //! Forward iterable range of subject tokens
+        class Tokens
+        {
+        public:
+            class const_iterator
+            {
+            public:
+                using value_type        = std::string_view;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = void;
+                using reference         = std::string_view;
+                using iterator_category = std::forward_iterator_tag;
+
+                constexpr const_iterator(std::string_view subject, size_t pos) noexcept
+                    : _subject(subject)
+                    , _pos(pos)
+                {
+                }
+
+                constexpr std::string_view operator*() const noexcept
+                {
+                    const auto end = _subject.find('.', _pos);
+                    return _subject.substr(_pos, end == std::string_view::npos ? std::string_view::npos : end - _pos);
+                }
+
+                constexpr const_iterator& operator++() noexcept
+                {
+                    const auto end = _subject.find('.', _pos);
+                    _pos           = end == std::string_view::npos ? std::string_view::npos : end + 1;
+                    return *this;
+                }
+
+                constexpr const_iterator operator++(int) noexcept
+                {
+                    auto copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                constexpr bool operator==(const const_iterator& other) const noexcept
+                {
+                    return _pos == other._pos;
+                }
+
+                constexpr bool operator!=(const const_iterator& other) const noexcept
+                {
+                    return _pos != other._pos;
+                }
+
+            private:
+                std::string_view _subject;
+                size_t           _pos;
+            };
+
+            constexpr explicit Tokens(std::string_view subject) noexcept
+                : _subject(subject)
+            {
+            }
+
+            constexpr const_iterator begin() const noexcept
+            {
+                return { _subject, _subject.empty() ? std::string_view::npos : 0 };
+            }
+
+            constexpr const_iterator end() const noexcept
+            {
+                return { _subject, std::string_view::npos };
+            }
+
+        private:
+            std::string_view _subject;
+        };
+
+        constexpr Tokens tokens(std::string_view subject) noexcept
+        {
+            return Tokens(subject);
+        }
+
+        constexpr size_t tokenCount(std::string_view subject) noexcept
+        {
+            if (subject.empty())
+                return 0;
+
+            size_t count{ 1 };
+            for (auto pos = subject.find('.'); pos != std::string_view::npos; pos = subject.find('.', pos + 1))
+                ++count;
+
+            return count;
+        }
+
+        //! Token by index, a negative index counts from the end. Empty view if there is no such token.
+        constexpr std::string_view token(std::string_view subject, int index) noexcept
+        {
+            const auto count = static_cast<int>(tokenCount(subject));
+            const auto idx   = index < 0 ? count + index : index;
+            if (idx < 0 || idx >= count)
+                return {};
+
+            auto it = tokens(subject).begin();
+            for (int i = 0; i < idx; ++i)
+                ++it;
+
+            return *it;
+        }
+
+        //! Subject must be non-empty, without empty tokens and whitespaces. Wildcards are allowed only for subscriptions
+        constexpr bool isValid(std::string_view subject, bool allowWildcards = false) noexcept
+        {
+            if (subject.empty())
+                return false;
+
+            for (auto it = tokens(subject).begin(), end = tokens(subject).end(); it != end;)
+            {
+                const auto token = *it;
+                if (token.empty())
+                    return false;
+
+                const auto last = ++it == end;
+                if ((token == "*" || token == ">") && !allowWildcards)
+                    return false;
+                if (token == ">" && !last)
+                    return false;
+
+                if (token.find_first_of(" \t\r\n") != std::string_view::npos)
+                    return false;
+            }
+
+            return true;
+        }
+
+        //! Check if the subject has a "*" or ">" token
+        constexpr bool hasWildcards(std::string_view subject) noexcept
+        {
+            // Fast path, most subjects have no wildcard characters at all
+            if (subject.find_first_of("*>") == std::string_view::npos)
+                return false;
+
+            for (const auto token : tokens(subject))
+            {
+                if (token == "*" || token == ">")
+                    return true;
+            }
+
+            return false;
+        }
+
+        //! Check if the subject matches the pattern the way the server does: "*" matches one token, ">" matches one or more tailing tokens.
+        //! Both arguments are expected to be valid.
+        constexpr bool matches(std::string_view pattern, std::string_view subject) noexcept
+        {
+            // Literal patterns are compared as a whole
+            if (pattern.find_first_of("*>") == std::string_view::npos)
+                return pattern == subject;
+
+            auto       p    = tokens(pattern).begin();
+            auto       s    = tokens(subject).begin();
+            const auto pend = tokens(pattern).end();
+            const auto send = tokens(subject).end();
+
+            for (; p != pend; ++p, ++s)
+            {
+                if (*p == ">")
+                    return s != send;
+
+                if (s == send)
+                    return false;
+
+                if (*p != "*" && *p != *s)
+                    return false;
+            }
+
+            return s == send;
+        }
+    }
+
+    //! Subject validated once, at construction. Functions taking Subject skip their own validation.
+    class NATSMQ_EXPORT Subject
+    {
+    public:
+        //! Subject for publishing, an exception is thrown if it is invalid or has wildcards
+        explicit Subject(std::string subject);
+
+        //! Subject for subscriptions, wildcards are allowed. An exception is thrown if it is invalid.
+        static Subject pattern(std::string subject);
+
+        const std::string& str() const noexcept;
+
+        operator std::string_view() const noexcept;
+
+        //! True if the subject has wildcards
+        bool isPattern() const noexcept;
+
+        //! Same as Subjects::matches(*this, subject)
+        bool matches(std::string_view subject) const noexcept;
+
+    private:
+        Subject(std::string subject, bool allowWildcards);
+
+    private:
+        std::string _subject;
+        bool        _pattern{ false };
+    };
+}
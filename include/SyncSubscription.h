@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "Entities.h"
 #include "Export.h"
@@ -26,6 +27,11 @@ namespace NatsMq
         //! Similar as next(), but waits message during the timeout
         Message next(int64_t timeoutMs) const;
 
+        //! Waits for the first message during the timeout, then takes the messages already queued without waiting, up to maxCount.
+        //! The vector is cleared, but its capacity is kept. Returns the number of received messages, zero on timeout.
+        //! An error met after some messages were taken is thrown by the next call, the taken messages are returned first.
+        size_t nextBatch(size_t maxCount, int64_t timeoutMs, std::vector<Message>& out) const;
+
         //! Get subscription statistics
         SubscriptionStatistic statistics() const;
 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "Executor.h"
+#include "Export.h"
+
+namespace NatsMq
+{
+    class ThreadPoolExecutorPrivate;
+
+    //! Work-stealing thread pool. Every thread has its own task queue, idle threads take tasks from the busy ones,
+    //! so a long task does not hold the tasks queued behind it. An exception thrown by a task is caught and counted.
+    class NATSMQ_EXPORT ThreadPoolExecutor final : public Executor
+    {
+    public:
+        //! Zero threads means the number of hardware threads
+        explicit ThreadPoolExecutor(int threads = 0);
+
+        //! Execute the queued tasks and join the threads
+        ~ThreadPoolExecutor() override;
+
+        ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+
+        ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+        void execute(Task task) override;
+
+        int threadCount() const noexcept;
+
+        //! Number of tasks waiting in the queues
+        size_t queuedTasks() const noexcept;
+
+        //! Number of tasks that threw an exception
+        size_t failedTasks() const noexcept;
+
+    private:
+        std::unique_ptr<ThreadPoolExecutorPrivate> _impl;
+    };
+}
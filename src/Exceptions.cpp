@@ -53,3 +53,9 @@ NatsMq::JsException::JsException(int s, int e)
     , jsError(static_cast<Js::Status>(e))
 {
 }
+
+NatsMq::ServiceError::ServiceError(int c, const std::string& description)
+    : std::runtime_error(description)
+    , code(c)
+{
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace NatsMq
+{
+    //! Copy-on-write list of callbacks with stable handles. Registration copies the list and publishes the copy
+    //! with one atomic store, so dispatch only loads a pointer: it never locks and never sees a half-updated list.
+    //! Replaced lists are freed by a later registration once no dispatch is running.
+    template <typename Callback>
+    class CallbackRegistry
+    {
+    public:
+        CallbackRegistry()
+        {
+            publish(std::make_unique<List>());
+        }
+
+        CallbackRegistry(const CallbackRegistry&) = delete;
+
+        CallbackRegistry& operator=(const CallbackRegistry&) = delete;
+
+        //! Returns a handle for remove(). Handles are never reused.
+        int add(Callback cb)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto list = std::make_unique<List>(*_current.load(std::memory_order_relaxed));
+            list->emplace_back(++_lastHandle, std::move(cb));
+            publish(std::move(list));
+
+            return _lastHandle;
+        }
+
+        //! Unknown handles are ignored
+        void remove(int handle)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            const auto& current = *_current.load(std::memory_order_relaxed);
+
+            auto list = std::make_unique<List>();
+            list->reserve(current.size());
+            for (auto&& entry : current)
+            {
+                if (entry.first != handle)
+                    list->push_back(entry);
+            }
+
+            if (list->size() != current.size())
+                publish(std::move(list));
+        }
+
+        bool empty() const noexcept
+        {
+            _readers.fetch_add(1);
+            const ReaderGuard guard{ _readers };
+
+            return _current.load()->empty();
+        }
+
+        //! Invoke all callbacks registered before the call
+        template <typename... Args>
+        void dispatch(Args&&... args) const
+        {
+            // Announce the reader before loading the list, so a writer that sees no readers knows nobody holds an old list
+            _readers.fetch_add(1);
+            const ReaderGuard guard{ _readers };
+
+            for (auto&& entry : *_current.load())
+                entry.second(args...);
+        }
+
+    private:
+        using List = std::vector<std::pair<int, Callback>>;
+
+        struct ReaderGuard
+        {
+            std::atomic<int>& readers;
+
+            ~ReaderGuard()
+            {
+                readers.fetch_sub(1);
+            }
+        };
+
+        //! Called under _mutex (or from the constructor)
+        void publish(std::unique_ptr<List> list)
+        {
+            _current.store(list.get());
+            _lists.push_back(std::move(list));
+
+            // Readers starting from now see the new list
+            if (_readers.load() == 0)
+                _lists.erase(_lists.begin(), _lists.end() - 1);
+        }
+
+    private:
+        std::atomic<const List*> _current{ nullptr };
+        mutable std::atomic<int> _readers{ 0 };
+
+        std::mutex                         _mutex;
+        std::vector<std::unique_ptr<List>> _lists;
+        int                                _lastHandle{ -1 };
+    };
+}
@@ -1,17 +1,110 @@
 #include "Client.h"
 
+#include <atomic>
+
+#include "Exceptions.h"
 #include "JetStream.h"
 #include "Message.h"
+#include "Router.h"
+#include "Subject.h"
+#include "Service.h"
 #include "core/Connection.h"
 #include "core/Publisher.h"
+#include "core/PublisherHandlePrivate.h"
 #include "core/Requestor.h"
+#include "core/RouterPrivate.h"
+#include "core/ServicePrivate.h"
 #include "core/SubscriptionPrivate.h"
 #include "core/SyncSubscriptionPrivate.h"
 #include "js/Context.h"
+#include "private/utils.h"
 #include "private/versioncontrol.h"
 
 using namespace NatsMq;
 
+namespace
+{
+    template <typename Func>
+    std::vector<Status> collectStatuses(size_t count, Func&& func)
+    {
+        std::vector<Status> statuses;
+        statuses.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            try
+            {
+                func(i);
+                statuses.push_back(Status::Ok);
+            }
+            catch (const Exception& exc)
+            {
+                statuses.push_back(exc.status);
+            }
+        }
+
+        return statuses;
+    }
+
+    Status holdOrPublish(Connection& connection, const Message& msg)
+    {
+        Message copy(msg);
+        if (connection.flushControl().hold(copy))
+            return Status::Ok;
+
+        return Publisher(connection.rawConnection()).tryPublish(msg);
+    }
+
+    Status holdOrPublish(Connection& connection, const RawMessage& msg)
+    {
+        if (connection.flushControl().hold(msg.subject, msg.data))
+            return Status::Ok;
+
+        return Publisher(connection.rawConnection()).tryPublish(msg);
+    }
+
+    //! Messages of the control lane subjects go through the control connection, so they are not stuck behind the bulk data
+    template <typename T>
+    std::vector<Status> publishBatchByLane(Connection& connection, const T* msgs, size_t count, int64_t flushTimeoutMs)
+    {
+        const auto control = connection.controlLane();
+        auto&      bulk    = connection.flushControl();
+
+        // Held messages go first to keep the order, does nothing while corked
+        bulk.release();
+
+        if (!control && !bulk.isCorked())
+            return Publisher(connection.rawConnection()).publishBatch(msgs, count, flushTimeoutMs);
+
+        if (control)
+            control->flushControl().release();
+
+        std::vector<Status> statuses;
+        statuses.reserve(count);
+
+        bool flushBulk{ false };
+        bool flushLane{ false };
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto lane = connection.controlLane(msgs[i].subject);
+            auto&      to   = lane ? *lane : connection;
+
+            statuses.push_back(holdOrPublish(to, msgs[i]));
+
+            auto& flush = lane ? flushLane : flushBulk;
+            flush       = flush || !to.flushControl().isCorked();
+        }
+
+        if (flushBulk)
+            Publisher(connection.rawConnection()).flush(flushTimeoutMs);
+        if (flushLane)
+            Publisher(control->rawConnection()).flush(flushTimeoutMs);
+
+        return statuses;
+    }
+}
+
 Client* Client::create()
 {
     const auto connection = new Connection();
@@ -24,6 +117,11 @@ Client::Client(Connection* connection)
     staticCheckEnumIntegrity();
 }
 
+Client::Client(std::shared_ptr<Connection> connection)
+    : _connection(std::move(connection))
+{
+}
+
 Client::~Client() = default;
 
 Client::Client(const Client&) = default;
@@ -62,55 +160,321 @@ IOStatistic Client::statistics() const
     return _connection->statistics();
 }
 
+Client Client::control() const
+{
+    if (auto control = _connection->controlLane())
+        return Client(std::move(control));
+
+    return *this;
+}
+
 void Client::publish(Message msg) const
 {
-    Publisher publisher(_connection->rawConnection());
+    auto& connection = lane(msg.subject);
+
+    if (connection.flushControl().hold(msg))
+        return;
+
+    Publisher publisher(connection.rawConnection());
     publisher.publish(std::move(msg));
 }
 
+void Client::publish(std::string_view subject, const void* data, size_t size) const
+{
+    auto& connection = lane(subject);
+
+    if (connection.flushControl().hold(subject, { static_cast<const uint8_t*>(data), size }))
+        return;
+
+    Publisher publisher(connection.rawConnection());
+    publisher.publish(subject, data, size);
+}
+
+void Client::publish(std::string_view subject, ByteSpan data) const
+{
+    publish(subject, data.data, data.size);
+}
+
+std::vector<Status> Client::publishBatch(const std::vector<Message>& msgs, int64_t flushTimeoutMs) const
+{
+    return publishBatch(msgs.data(), msgs.size(), flushTimeoutMs);
+}
+
+std::vector<Status> Client::publishBatch(const Message* msgs, size_t count, int64_t flushTimeoutMs) const
+{
+    return publishBatchByLane(*_connection, msgs, count, flushTimeoutMs);
+}
+
+std::vector<Status> Client::publishBatch(const std::vector<RawMessage>& msgs, int64_t flushTimeoutMs) const
+{
+    return publishBatch(msgs.data(), msgs.size(), flushTimeoutMs);
+}
+
+std::vector<Status> Client::publishBatch(const RawMessage* msgs, size_t count, int64_t flushTimeoutMs) const
+{
+    return publishBatchByLane(*_connection, msgs, count, flushTimeoutMs);
+}
+
+void Client::flush(int64_t timeoutMs) const
+{
+    _connection->flushControl().release();
+    _connection->flush(timeoutMs);
+}
+
+void Client::cork() const
+{
+    _connection->flushControl().cork();
+}
+
+std::vector<Status> Client::uncork() const
+{
+    return _connection->flushControl().uncork(_connection->rawConnection());
+}
+
+PublisherHandle* Client::publisher(const std::string& subject) const
+{
+    auto connection = _connection->controlLane(subject) ? _connection->controlLane() : _connection;
+    return new PublisherHandle(new PublisherHandlePrivate(std::move(connection), subject));
+}
+
 Message Client::request(Message msg, uint64_t timeoutMs) const
 {
-    Requestor requestor(_connection->rawConnection());
+    auto& connection = lane(msg.subject);
+
+    if (connection.requestCoalescer() || connection.replyCache())
+        return arequest(std::move(msg), timeoutMs).get();
+
+    connection.flushControl().release();
+
+    Requestor requestor(connection.rawConnection());
     return requestor.request(std::move(msg), timeoutMs);
 }
 
+Message Client::request(const Message& msg, uint64_t timeoutMs, const RequestPolicy& policy) const
+{
+    auto& connection = lane(msg.subject);
+    connection.flushControl().release();
+
+    const auto mux = connection.responseMux();
+
+    Requestor requestor(connection.rawConnection(), mux.get());
+    return requestor.request(msg, timeoutMs, policy);
+}
+
 std::future<Message> Client::arequest(Message msg, uint64_t timeoutMs) const
 {
-    Requestor requestor(_connection->rawConnection());
-    return requestor.arequest(std::move(msg), timeoutMs);
+    // std::function requires a copyable callable
+    auto promise = std::make_shared<std::promise<Message>>();
+    auto future  = promise->get_future();
+
+    request(std::move(msg), timeoutMs, [promise](Result<Message> result) {
+        if (result)
+            promise->set_value(std::move(result).value());
+        else
+            promise->set_exception(std::make_exception_ptr(Exception(result.status())));
+    });
+
+    return future;
+}
+
+void Client::request(Message msg, uint64_t timeoutMs, RequestCb cb) const
+{
+    auto& connection = lane(msg.subject);
+
+    const auto cache = connection.replyCache();
+    if (cache && ReplyCache::isCacheable(msg))
+    {
+        auto key = requestKey(msg);
+
+        if (auto reply = cache->get(key))
+            return cb(std::move(*reply));
+
+        const auto generation = cache->generation(key);
+
+        cb = [cache, key = std::move(key), generation, cb = std::move(cb)](Result<Message> result) {
+            if (result)
+                cache->put(key, result.value(), generation);
+            cb(std::move(result));
+        };
+    }
+
+    // Requests are not held, publishes held before them are sent first
+    connection.flushControl().release();
+
+    const auto mux = connection.responseMux();
+
+    if (const auto coalescer = connection.requestCoalescer())
+        coalescer->request(*mux, std::move(msg), timeoutMs, std::move(cb));
+    else
+        mux->request(std::move(msg), timeoutMs, std::move(cb));
+}
+
+void Client::requestBatch(std::vector<Message> msgs, uint64_t timeoutMs, RequestBatchCb cb) const
+{
+    const auto control = _connection->controlLane();
+
+    std::vector<size_t> controlIdx;
+    if (control)
+    {
+        for (size_t i = 0; i < msgs.size(); ++i)
+        {
+            if (_connection->controlLane(msgs[i].subject))
+                controlIdx.push_back(i);
+        }
+    }
+
+    // Requests are not held, publishes held before them are sent first
+    const auto send = [timeoutMs](Connection& connection, std::vector<Message> batch, RequestBatchCb done) {
+        connection.flushControl().release();
+        connection.responseMux()->requestBatch(std::move(batch), timeoutMs, std::move(done));
+    };
+
+    if (controlIdx.empty())
+        return send(*_connection, std::move(msgs), std::move(cb));
+    if (controlIdx.size() == msgs.size())
+        return send(*control, std::move(msgs), std::move(cb));
+
+    // Each lane sends its part as one batch, the part completed last fires the callback
+    struct Batch
+    {
+        std::vector<Result<Message>> results;
+        std::atomic<int>             remaining{ 2 };
+        RequestBatchCb               callback;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    batch->results.assign(msgs.size(), Result<Message>(Status::Timeout));
+    batch->callback = std::move(cb);
+
+    std::vector<size_t>  bulkIdx;
+    std::vector<Message> bulkMsgs;
+    std::vector<Message> controlMsgs;
+
+    for (size_t i = 0, c = 0; i < msgs.size(); ++i)
+    {
+        if (c < controlIdx.size() && controlIdx[c] == i)
+        {
+            controlMsgs.push_back(std::move(msgs[i]));
+            ++c;
+            continue;
+        }
+
+        bulkIdx.push_back(i);
+        bulkMsgs.push_back(std::move(msgs[i]));
+    }
+
+    const auto merge = [batch](std::vector<size_t> indices) {
+        return [batch, indices = std::move(indices)](std::vector<Result<Message>> results) {
+            for (size_t i = 0; i < results.size(); ++i)
+                batch->results[indices[i]] = std::move(results[i]);
+
+            if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                batch->callback(std::move(batch->results));
+        };
+    };
+
+    send(*control, std::move(controlMsgs), merge(std::move(controlIdx)));
+    send(*_connection, std::move(bulkMsgs), merge(std::move(bulkIdx)));
+}
+
+std::vector<Message> Client::requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs) const
+{
+    auto& connection = lane(msg.subject);
+    connection.flushControl().release();
+
+    Requestor requestor(connection.rawConnection());
+    return requestor.requestMany(std::move(msg), maxReplies, timeoutMs);
+}
+
+void Client::requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs, RequestManyCb cb) const
+{
+    auto& connection = lane(msg.subject);
+    connection.flushControl().release();
+
+    Requestor requestor(connection.rawConnection());
+    requestor.requestMany(std::move(msg), maxReplies, timeoutMs, cb);
+}
+
+PublisherHandle* Client::publisher(const Subject& subject) const
+{
+    auto connection = _connection->controlLane(subject) ? _connection->controlLane() : _connection;
+    return new PublisherHandle(new PublisherHandlePrivate(std::move(connection), subject));
 }
 
 Subscription* Client::subscribe(const std::string& subject, SubscriptionCb cb) const
 {
-    auto impl = new SubscriptionPrivate(_connection->rawConnection(), subject);
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(lane(subject).rawConnection(), subject));
     impl->registerListener(std::move(cb));
-    return new Subscription(impl);
+    return new Subscription(impl.release());
 }
 
 Subscription* Client::subscribe(const std::string& subject, int64_t timeoutMs, SubscriptionCb cb) const
 {
-    auto impl = new SubscriptionPrivate(_connection->rawConnection(), subject, timeoutMs);
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(lane(subject).rawConnection(), subject, {}, timeoutMs));
     impl->registerListener(std::move(cb));
-    return new Subscription(impl);
+    return new Subscription(impl.release());
 }
 
 Subscription* Client::subscribe(const std::string& subject, const std::string& queue, SubscriptionCb cb) const
 {
-    auto impl = new SubscriptionPrivate(_connection->rawConnection(), subject, queue);
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(lane(subject).rawConnection(), subject, queue));
     impl->registerListener(std::move(cb));
-    return new Subscription(impl);
+    return new Subscription(impl.release());
 }
 
 Subscription* Client::subscribe(const std::string& subject, const std::string& queue, int64_t timeoutMs, SubscriptionCb cb) const
 {
-    auto impl = new SubscriptionPrivate(_connection->rawConnection(), subject, queue, timeoutMs);
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(lane(subject).rawConnection(), subject, queue, timeoutMs));
+    impl->registerListener(std::move(cb));
+    return new Subscription(impl.release());
+}
+
+Subscription* Client::subscribe(const std::string& subject, const std::string& queue, const DeliveryOptions& delivery, SubscriptionCb cb) const
+{
+    auto& connection = lane(subject);
+
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(connection.rawConnection(), subject, queue));
+    impl->registerListener(std::move(cb), delivery, connection.errorSink());
+    return new Subscription(impl.release());
+}
+
+Subscription* Client::subscribeBatch(const std::string& subject, size_t maxBatch, uint64_t maxLatencyMs, SubscriptionBatchCb cb) const
+{
+    auto& connection = lane(subject);
+
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(connection.rawConnection(), subject));
+    impl->registerListener(std::move(cb), maxBatch, maxLatencyMs, connection.errorSink());
+    return new Subscription(impl.release());
+}
+
+Subscription* Client::subscribeView(const std::string& subject, SubscriptionViewCb cb) const
+{
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(lane(subject).rawConnection(), subject));
+    impl->registerListener(std::move(cb));
+    return new Subscription(impl.release());
+}
+
+Subscription* Client::subscribeView(const std::string& subject, const std::string& queue, SubscriptionViewCb cb) const
+{
+    std::unique_ptr<SubscriptionPrivate> impl(new SubscriptionPrivate(lane(subject).rawConnection(), subject, queue));
     impl->registerListener(std::move(cb));
-    return new Subscription(impl);
+    return new Subscription(impl.release());
+}
+
+Router* Client::router(const std::string& subject, const std::string& queue, const DeliveryOptions& delivery) const
+{
+    auto& connection = lane(subject);
+    return new Router(new RouterPrivate(connection.rawConnection(), subject, queue, delivery, connection.errorSink()));
 }
 
 SyncSubscription* Client::syncSubscribe(const std::string& subject, const std::string& queue) const
 {
-    return new SyncSubscription(queue.empty() ? new SyncSubscriptionPrivate(_connection->rawConnection(), subject) : new SyncSubscriptionPrivate(_connection->rawConnection(), subject, queue));
+    return new SyncSubscription(queue.empty() ? new SyncSubscriptionPrivate(lane(subject).rawConnection(), subject) : new SyncSubscriptionPrivate(lane(subject).rawConnection(), subject, queue));
+}
+
+Service* Client::service(const ServiceConfig& config) const
+{
+    return new Service(new ServicePrivate(_connection->rawConnection(), config));
 }
 
 JetStream* Client::jetstream(const Js::Options& options) const
@@ -138,3 +502,19 @@ void Client::unregisterErrorCallback(int idx) const
 {
     _connection->unregisterErrorCallback(idx);
 }
+
+int Client::registerErrorReportCallback(ErrorReportCb cb)
+{
+    return _connection->registerErrorReportCallback(std::move(cb));
+}
+
+void Client::unregisterErrorReportCallback(int idx) const
+{
+    _connection->unregisterErrorReportCallback(idx);
+}
+
+Connection& Client::lane(std::string_view subject) const
+{
+    const auto control = _connection->controlLane(subject);
+    return control ? *control : *_connection;
+}
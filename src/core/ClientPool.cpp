@@ -0,0 +1,95 @@
+#include "ClientPool.h"
+
+#include "ClientPoolPrivate.h"
+#include "Message.h"
+
+using namespace NatsMq;
+
+ClientPool* ClientPool::create(size_t connections, PoolRouting routing)
+{
+    return new ClientPool(new ClientPoolPrivate(connections, routing));
+}
+
+ClientPool::ClientPool(ClientPoolPrivate* impl)
+    : _impl(impl)
+{
+}
+
+ClientPool::~ClientPool() = default;
+
+ClientPool::ClientPool(ClientPool&&) = default;
+
+ClientPool& ClientPool::operator=(ClientPool&&) = default;
+
+void ClientPool::connect(const Client::Urls& hosts, const ConnectionOptions& options) const
+{
+    _impl->connect(hosts, options);
+}
+
+void ClientPool::disconnect() const
+{
+    _impl->disconnect();
+}
+
+size_t ClientPool::size() const noexcept
+{
+    return _impl->size();
+}
+
+const Client& ClientPool::client(size_t index) const
+{
+    return _impl->client(index);
+}
+
+const Client& ClientPool::clientFor(std::string_view subject) const
+{
+    return _impl->clientFor(subject);
+}
+
+IOStatistic ClientPool::statistics() const
+{
+    return _impl->statistics();
+}
+
+void ClientPool::publish(Message msg) const
+{
+    const auto& client = _impl->clientFor(msg.subject);
+    client.publish(std::move(msg));
+}
+
+void ClientPool::publish(std::string_view subject, const void* data, size_t size) const
+{
+    _impl->clientFor(subject).publish(subject, data, size);
+}
+
+void ClientPool::publish(std::string_view subject, ByteSpan data) const
+{
+    _impl->clientFor(subject).publish(subject, data);
+}
+
+void ClientPool::flush(int64_t timeoutMs) const
+{
+    _impl->flush(timeoutMs);
+}
+
+Message ClientPool::request(Message msg, uint64_t timeoutMs) const
+{
+    const auto& client = _impl->clientFor(msg.subject);
+    return client.request(std::move(msg), timeoutMs);
+}
+
+std::future<Message> ClientPool::arequest(Message msg, uint64_t timeoutMs) const
+{
+    const auto& client = _impl->clientFor(msg.subject);
+    return client.arequest(std::move(msg), timeoutMs);
+}
+
+Subscription* ClientPool::subscribe(const std::string& subject, SubscriptionCb cb) const
+{
+    return _impl->clientFor(subject).subscribe(subject, std::move(cb));
+}
+
+Subscription* ClientPool::subscribe(const std::string& subject, const std::string& queueGroup, SubscriptionCb cb) const
+{
+    return _impl->clientFor(subject).subscribe(subject, queueGroup, std::move(cb));
+}
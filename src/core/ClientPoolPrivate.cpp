@@ -0,0 +1,76 @@
+#include "ClientPoolPrivate.h"
+
+#include <functional>
+#include <memory>
+
+#include "Exceptions.h"
+
+using namespace NatsMq;
+
+ClientPoolPrivate::ClientPoolPrivate(size_t connections, PoolRouting routing)
+    : _routing(routing)
+{
+    if (!connections)
+        throw Exception(Status::InvalidArg);
+
+    _clients.reserve(connections);
+    for (size_t i = 0; i < connections; ++i)
+        _clients.push_back(*std::unique_ptr<Client>(Client::create()));
+}
+
+void ClientPoolPrivate::connect(const Client::Urls& hosts, const ConnectionOptions& options) const
+{
+    for (auto&& client : _clients)
+        client.connect(hosts, options);
+}
+
+void ClientPoolPrivate::disconnect() const
+{
+    for (auto&& client : _clients)
+        client.disconnect();
+}
+
+size_t ClientPoolPrivate::size() const noexcept
+{
+    return _clients.size();
+}
+
+const Client& ClientPoolPrivate::client(size_t index) const
+{
+    if (index >= _clients.size())
+        throw Exception(Status::InvalidArg);
+
+    return _clients[index];
+}
+
+const Client& ClientPoolPrivate::clientFor(std::string_view subject) const
+{
+    if (_clients.size() == 1)
+        return _clients.front();
+
+    const auto index = _routing == PoolRouting::SubjectHash ? std::hash<std::string_view>{}(subject) : _next.fetch_add(1, std::memory_order_relaxed);
+    return _clients[index % _clients.size()];
+}
+
+IOStatistic ClientPoolPrivate::statistics() const
+{
+    IOStatistic total{};
+
+    for (auto&& client : _clients)
+    {
+        const auto stats = client.statistics();
+        total.inMsgs += stats.inMsgs;
+        total.inBytes += stats.inBytes;
+        total.outMsgs += stats.outMsgs;
+        total.outBytes += stats.outBytes;
+        total.reconnected += stats.reconnected;
+    }
+
+    return total;
+}
+
+void ClientPoolPrivate::flush(int64_t timeoutMs) const
+{
+    for (auto&& client : _clients)
+        client.flush(timeoutMs);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+#include "Client.h"
+#include "Entities.h"
+
+namespace NatsMq
+{
+    class ClientPoolPrivate
+    {
+    public:
+        ClientPoolPrivate(size_t connections, PoolRouting routing);
+
+        void connect(const Client::Urls& hosts, const ConnectionOptions& options) const;
+
+        void disconnect() const;
+
+        size_t size() const noexcept;
+
+        const Client& client(size_t index) const;
+
+        const Client& clientFor(std::string_view subject) const;
+
+        IOStatistic statistics() const;
+
+        void flush(int64_t timeoutMs) const;
+
+    private:
+        const PoolRouting   _routing;
+        std::vector<Client> _clients;
+
+        mutable std::atomic<size_t> _next{ 0 };
+    };
+}
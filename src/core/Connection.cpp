@@ -4,6 +4,7 @@
 
 #include "Entities.h"
 #include "Exceptions.h"
+#include "Subject.h"
 #include "private/utils.h"
 
 using namespace NatsMq;
@@ -27,19 +28,31 @@ namespace
         NatsMq::exceptionIfError(natsOptions_SetMaxReconnect(opts, options.maxReconnect));
         NatsMq::exceptionIfError(natsOptions_SetReconnectWait(opts, options.reconnectWait));
         NatsMq::exceptionIfError(natsOptions_SetReconnectBufSize(opts, options.reconnectBufferSize));
+        NatsMq::exceptionIfError(natsOptions_SetIOBufSize(opts, options.IOBufferSize));
         NatsMq::exceptionIfError(natsOptions_SetMaxPendingMsgs(opts, options.maxPendingMessages));
+        NatsMq::exceptionIfError(natsOptions_SetMaxPendingBytes(opts, options.maxPendingBytes));
         NatsMq::exceptionIfError(natsOptions_SetNoEcho(opts, !options.echo));
         NatsMq::exceptionIfError(natsOptions_SetRetryOnFailedConnect(opts, options.retryOnFailedConnect, nullptr, nullptr));
         NatsMq::exceptionIfError(natsOptions_SetSendAsap(opts, options.sendAsap));
         NatsMq::exceptionIfError(natsOptions_UseGlobalMessageDelivery(opts, options.useGlobalMsgDelivery));
         NatsMq::exceptionIfError(natsOptions_SetFailRequestsOnDisconnect(opts, options.failRequestOnDisconnect));
+        NatsMq::exceptionIfError(natsOptions_DisableNoResponders(opts, options.disableNoResponders));
+
+        if (!options.name.empty())
+            NatsMq::exceptionIfError(natsOptions_SetName(opts, options.name.c_str()));
+        if (!options.token.empty())
+            NatsMq::exceptionIfError(natsOptions_SetToken(opts, options.token.c_str()));
+        if (!options.userCreds.login.empty())
+            NatsMq::exceptionIfError(natsOptions_SetUserInfo(opts, options.userCreds.login.c_str(), options.userCreds.password.c_str()));
+
         return opts;
     }
 
 }
 
 NatsMq::Connection::Connection()
-    : _connection(nullptr, &natsConnection_Destroy)
+    : _callbacks(std::make_shared<Callbacks>())
+    , _connection(nullptr, &natsConnection_Destroy)
     , _options(nullptr, &natsOptions_Destroy)
 {
 }
@@ -58,6 +71,12 @@ void Connection::connect(const Urls& hosts, const ConnectionOptions& options)
     if (hosts.empty())
         return;
 
+    for (auto&& subject : options.controlLane.subjects)
+    {
+        if (!Subjects::isValid(subject, true))
+            exceptionIfError(Status::InvalidSubject);
+    }
+
     _options.reset(createNatsOptions(options));
 
     auto natsOptions = _options.get();
@@ -65,6 +84,9 @@ void Connection::connect(const Urls& hosts, const ConnectionOptions& options)
     setErrorHandler(natsOptions);
     setConnectionHandlers(natsOptions);
 
+    if (options.errorReports.windowMs > 0)
+        _errorAggregator = std::make_unique<ErrorAggregator>(options.errorReports.windowMs, [this](const ErrorReport& report) { errorReported(report); });
+
     auto urlPointers = createArrayPointersToElements(hosts);
 
     exceptionIfError(natsOptions_SetServers(natsOptions, urlPointers.data(), static_cast<int>(urlPointers.size())));
@@ -73,13 +95,90 @@ void Connection::connect(const Urls& hosts, const ConnectionOptions& options)
     natsConnection* connection;
     exceptionIfError(natsConnection_Connect(&connection, natsOptions));
     _connection.reset(connection);
+
+    _coalesceRequests = options.coalesceRequests;
+
+    if (options.replyCache.maxEntries > 0)
+        _replyCache = std::make_unique<ReplyCache>(connection, options.replyCache);
+
+    if (!options.sendAsap)
+        _flushControl.start(connection, options.flushPolicy, [this](Status status) {
+            if (!_callbacks->errors.empty())
+                errorOccured(status, natsStatus_GetText(static_cast<natsStatus>(status)));
+        });
+
+    if (options.controlLane.enabled)
+    {
+        auto control         = options;
+        control.sendAsap     = true;
+        control.IOBufferSize = options.controlLane.IOBufferSize;
+        control.controlLane  = {};
+        control.replyCache   = {};
+
+        _control             = std::make_shared<Connection>();
+        _control->_callbacks = _callbacks;
+
+        try
+        {
+            _control->connect(hosts, control);
+        }
+        catch (...)
+        {
+            // The client is either connected with both lanes or not connected at all
+            disconnect();
+            throw;
+        }
+
+        _controlSubjects = options.controlLane.subjects;
+    }
+
     stateChanged(ConnectionStatus::Connected);
 }
 
 void Connection::disconnect()
 {
+    _flushControl.stop();
+
+    std::shared_ptr<ResponseMux> mux;
+
+    {
+        std::lock_guard<std::mutex> lock(_muxMutex);
+        mux.swap(_responseMux);
+    }
+
+    // Destroyed here unless a request in progress holds it, before the connection it subscribes on
+    mux.reset();
+
+    _replyCache.reset();
+
+    if (_control)
+        _control->disconnect();
+    _control.reset();
+    _controlSubjects.clear();
+
     _connection.reset();
     _options.reset();
+
+    _errorAggregator.reset();
+}
+
+Connection* Connection::controlLane(std::string_view subject) const noexcept
+{
+    if (!_control)
+        return nullptr;
+
+    for (auto&& pattern : _controlSubjects)
+    {
+        if (Subjects::matches(pattern, subject))
+            return _control.get();
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<Connection> Connection::controlLane() const
+{
+    return _control;
 }
 
 bool Connection::ping(int timeout) const noexcept
@@ -106,24 +205,32 @@ IOStatistic Connection::statistics() const
 
 int Connection::registerConnectionCallback(ConnectionStateCb cb)
 {
-    _connectionCallbacks.push_back(std::move(cb));
-    return static_cast<int>(_connectionCallbacks.size()) - 1;
+    return _connectionCallbacks.add(std::move(cb));
 }
 
 int Connection::registerErrorCallback(ErrorCb cb)
 {
-    _errorCallbacks.push_back(std::move(cb));
-    return static_cast<int>(_errorCallbacks.size()) - 1;
+    return _callbacks->errors.add(std::move(cb));
 }
 
 void Connection::unregisterConnectionCallback(int idx)
 {
-    _connectionCallbacks.erase(_connectionCallbacks.begin() + idx);
+    _connectionCallbacks.remove(idx);
 }
 
 void Connection::unregisterErrorCallback(int idx)
 {
-    _errorCallbacks.erase(_errorCallbacks.begin() + idx);
+    _callbacks->errors.remove(idx);
+}
+
+int Connection::registerErrorReportCallback(ErrorReportCb cb)
+{
+    return _callbacks->reports.add(std::move(cb));
+}
+
+void Connection::unregisterErrorReportCallback(int idx)
+{
+    _callbacks->reports.remove(idx);
 }
 
 natsConnection* NatsMq::Connection::rawConnection() const
@@ -131,6 +238,44 @@ natsConnection* NatsMq::Connection::rawConnection() const
     return _connection.get();
 }
 
+ErrorCb Connection::errorSink()
+{
+    return [weak = weak_from_this()](Status status, const std::string& text) {
+        if (const auto connection = weak.lock())
+            connection->errorOccured(status, text);
+    };
+}
+
+void Connection::flush(int64_t timeoutMs) const
+{
+    exceptionIfError(natsConnection_FlushTimeout(_connection.get(), timeoutMs));
+}
+
+FlushControl& Connection::flushControl()
+{
+    return _flushControl;
+}
+
+std::shared_ptr<ResponseMux> Connection::responseMux()
+{
+    std::lock_guard<std::mutex> lock(_muxMutex);
+
+    if (!_responseMux)
+        _responseMux = std::make_shared<ResponseMux>(_connection.get());
+
+    return _responseMux;
+}
+
+RequestCoalescer* Connection::requestCoalescer()
+{
+    return _coalesceRequests ? &_requestCoalescer : nullptr;
+}
+
+ReplyCache* Connection::replyCache()
+{
+    return _replyCache.get();
+}
+
 void NatsMq::Connection::setConnectionHandlers(natsOptions* options)
 {
     auto statusChangedCb = [](natsConnection* nc, void* closure) {
@@ -145,9 +290,36 @@ void NatsMq::Connection::setConnectionHandlers(natsOptions* options)
 
 void NatsMq::Connection::setErrorHandler(natsOptions* options)
 {
-    auto cb = [](natsConnection* /*nc*/, natsSubscription* /*subscription*/, natsStatus err, void* closure) {
+    auto cb = [](natsConnection* /*nc*/, natsSubscription* subscription, natsStatus err, void* closure) {
         const auto connection = reinterpret_cast<Connection*>(closure);
-        connection->errorOccured(static_cast<Status>(err), natsStatus_GetText(err));
+        const auto status     = static_cast<Status>(err);
+
+        // Slow consumer storms call this very often: only count the error if aggregation is on,
+        // and do not build the text if nobody listens
+        if (connection->_errorAggregator)
+        {
+            connection->_errorAggregator->record(status, subscription);
+            return;
+        }
+
+        if (!connection->_callbacks->errors.empty())
+            connection->errorOccured(status, natsStatus_GetText(err));
+
+        if (!connection->_callbacks->reports.empty())
+        {
+            ErrorReport report;
+            report.status = status;
+            report.text   = natsStatus_GetText(err);
+            report.count  = 1;
+            if (subscription)
+            {
+                report.subscriptionId = natsSubscription_GetID(subscription);
+                if (const char* subject = natsSubscription_GetSubject(subscription))
+                    report.subject = subject;
+                natsSubscription_GetDropped(subscription, &report.droppedMessages);
+            }
+            connection->_callbacks->reports.dispatch(report);
+        }
     };
 
     natsOptions_SetErrorHandler(options, cb, this);
@@ -155,12 +327,25 @@ void NatsMq::Connection::setErrorHandler(natsOptions* options)
 
 void Connection::stateChanged(ConnectionStatus state) const
 {
-    for (auto&& cb : _connectionCallbacks)
-        cb(state);
+    _connectionCallbacks.dispatch(state);
 }
 
 void Connection::errorOccured(NatsMq::Status status, const std::string& text) const
 {
-    for (auto&& cb : _errorCallbacks)
-        cb(status, text);
+    _callbacks->errors.dispatch(status, text);
+}
+
+void Connection::errorReported(const ErrorReport& report) const
+{
+    if (!_callbacks->errors.empty())
+    {
+        std::string text = report.text;
+        if (report.subscriptionId)
+            text += " (subscription " + std::to_string(report.subscriptionId) + " on '" + report.subject + "', " + std::to_string(report.droppedMessages) + " dropped)";
+        text += ", " + std::to_string(report.count) + " times";
+
+        errorOccured(report.status, text);
+    }
+
+    _callbacks->reports.dispatch(report);
 }
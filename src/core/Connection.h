@@ -4,13 +4,21 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "Entities.h"
+#include "core/CallbackRegistry.h"
+#include "core/ErrorAggregator.h"
+#include "core/FlushControl.h"
+#include "core/ReplyCache.h"
+#include "core/RequestCoalescer.h"
+#include "core/ResponseMux.h"
 
 namespace NatsMq
 {
-    class Connection
+    class Connection : public std::enable_shared_from_this<Connection>
     {
     public:
         using Urls              = std::vector<std::string>;
@@ -39,8 +47,34 @@ namespace NatsMq
 
         void unregisterErrorCallback(int idx);
 
+        int registerErrorReportCallback(ErrorReportCb cb);
+
+        void unregisterErrorReportCallback(int idx);
+
         natsConnection* rawConnection() const;
 
+        //! Passes errors to the error callbacks, does nothing once the connection is destroyed
+        ErrorCb errorSink();
+
+        void flush(int64_t timeoutMs) const;
+
+        FlushControl& flushControl();
+
+        //! Shared inbox for async requests, created on first use. Callers keep it alive while they use it, disconnect() only drops the connection's reference.
+        std::shared_ptr<ResponseMux> responseMux();
+
+        //! Single-flight table of requests, nullptr if request coalescing is disabled
+        RequestCoalescer* requestCoalescer();
+
+        //! Reply cache, nullptr if it is disabled
+        ReplyCache* replyCache();
+
+        //! Control connection if the subject matches the control lane subjects, otherwise nullptr
+        Connection* controlLane(std::string_view subject) const noexcept;
+
+        //! Control connection, nullptr if the control lane is disabled
+        std::shared_ptr<Connection> controlLane() const;
+
     private:
         void setConnectionHandlers(natsOptions* options);
 
@@ -50,11 +84,37 @@ namespace NatsMq
 
         void errorOccured(NatsMq::Status status, const std::string& text) const;
 
+        void errorReported(const ErrorReport& report) const;
+
     private:
-        std::vector<ConnectionStateCb> _connectionCallbacks;
-        std::vector<ErrorCb>           _errorCallbacks;
+        struct Callbacks
+        {
+            CallbackRegistry<ErrorCb>       errors;
+            CallbackRegistry<ErrorReportCb> reports;
+        };
+
+        //! Own for each connection, so state changes of the control connection are seen only through its client
+        CallbackRegistry<ConnectionStateCb> _connectionCallbacks;
+
+        //! Shared with the control connection, so the callbacks also see its errors
+        std::shared_ptr<Callbacks> _callbacks;
+
+        //! Set before connecting and reset after the connection is destroyed, so the error handler can use it freely
+        std::unique_ptr<ErrorAggregator> _errorAggregator;
 
         NatsConnectionPtr _connection;
         NatsOptionsPtr    _options;
+        FlushControl      _flushControl;
+
+        bool             _coalesceRequests{ false };
+        RequestCoalescer _requestCoalescer;
+
+        std::mutex                   _muxMutex;
+        std::shared_ptr<ResponseMux> _responseMux;
+
+        std::unique_ptr<ReplyCache> _replyCache;
+
+        std::shared_ptr<Connection> _control;
+        std::vector<std::string>    _controlSubjects;
     };
 }
@@ -0,0 +1,45 @@
+#include "ConnectionProfiles.h"
+
+using namespace NatsMq;
+
+ConnectionOptions ConnectionProfiles::lowLatency()
+{
+    ConnectionOptions options;
+    options.sendAsap            = true;
+    options.IOBufferSize        = 8 * 1024;
+    options.maxPendingMessages  = 65536;
+    options.maxPendingBytes     = 16 * 1024 * 1024;
+    options.reconnectBufferSize = 1024 * 1024;
+    options.pingInterval        = 5000;
+    options.maxPingsOut         = 2;
+    return options;
+}
+
+ConnectionOptions ConnectionProfiles::highThroughput()
+{
+    ConnectionOptions options;
+    options.sendAsap                     = false;
+    options.IOBufferSize                 = 256 * 1024;
+    options.maxPendingMessages           = 1024 * 1024;
+    options.maxPendingBytes              = 256 * 1024 * 1024;
+    options.reconnectBufferSize          = 64 * 1024 * 1024;
+    options.pingInterval                 = 60000;
+    options.flushPolicy.maxBufferedBytes = 256 * 1024;
+    options.flushPolicy.maxDelayUs       = 1000;
+    return options;
+}
+
+ConnectionOptions ConnectionProfiles::largePayload()
+{
+    ConnectionOptions options;
+    options.sendAsap                     = false;
+    options.IOBufferSize                 = 1024 * 1024;
+    options.maxPendingMessages           = 4096;
+    options.maxPendingBytes              = 1024 * 1024 * 1024;
+    options.reconnectBufferSize          = 256 * 1024 * 1024;
+    options.pingInterval                 = 60000;
+    options.timeout                      = 10000;
+    options.flushPolicy.maxBufferedBytes = 4 * 1024 * 1024;
+    options.flushPolicy.maxDelayUs       = 5000;
+    return options;
+}
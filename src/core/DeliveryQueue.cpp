@@ -0,0 +1,244 @@
+#include "DeliveryQueue.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <unordered_set>
+
+#include "Exceptions.h"
+#include "ThreadPoolExecutor.h"
+#include "core/WorkerPool.h"
+
+using namespace NatsMq;
+
+namespace
+{
+    //! Tasks executed per executor call, bounds how long one subscription can hold an executor thread
+    constexpr size_t batchSize{ 64 };
+
+    std::mutex& registryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::unordered_set<DeliveryQueue*>& registry()
+    {
+        static std::unordered_set<DeliveryQueue*> queues;
+        return queues;
+    }
+
+    //! Runs the lanes of KeyOrdered subscriptions without their own executor. Lanes are only queues,
+    //! so the number of threads does not grow with the number of subscriptions.
+    std::shared_ptr<Executor> sharedLanesExecutor()
+    {
+        static const auto executor = std::make_shared<ThreadPoolExecutor>();
+        return executor;
+    }
+}
+
+DeliveryQueue::DeliveryQueue(const DeliveryOptions& options, int64_t subscriptionId, std::string subject, ErrorCb onError)
+    : _mode(options.mode)
+    , _subscriptionId(subscriptionId)
+    , _subject(std::move(subject))
+{
+    if (_mode == DeliveryMode::Executor && !options.executor)
+        throw Exception(Status::InvalidArg);
+
+    if (_mode == DeliveryMode::KeyOrdered && (!options.key || options.lanes < 0))
+        throw Exception(Status::InvalidArg);
+
+    size_t lanes{ 1 };
+    if (_mode == DeliveryMode::KeyOrdered)
+        lanes = options.lanes > 0 ? size_t(options.lanes) : std::max(1u, std::thread::hardware_concurrency());
+
+    Executor* executor{ nullptr };
+    if (_mode == DeliveryMode::Dedicated)
+    {
+        _dedicated = std::make_unique<WorkerPool>(1);
+        executor   = _dedicated.get();
+    }
+    else
+    {
+        _executor = _mode == DeliveryMode::KeyOrdered && !options.executor ? sharedLanesExecutor() : options.executor;
+        executor  = _executor.get();
+    }
+
+    _lanes.reserve(lanes);
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        _lanes.push_back(std::make_shared<State>());
+        _lanes.back()->executor = executor;
+        _lanes.back()->onError  = onError;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().insert(this);
+}
+
+DeliveryQueue::~DeliveryQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().erase(this);
+    }
+
+    for (auto&& state : _lanes)
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->closed   = true;
+        state->executor = nullptr;
+        state->tasks.clear();
+    }
+
+    // The dedicated threads are joined here, the scheduled batches see the closed state and exit
+    _dedicated.reset();
+}
+
+void DeliveryQueue::post(Executor::Task task)
+{
+    post(0, std::move(task));
+}
+
+void DeliveryQueue::post(size_t lane, Executor::Task task)
+{
+    const auto& state = _lanes[lane % _lanes.size()];
+
+    Executor* executor{ nullptr };
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed)
+            return;
+
+        state->tasks.push_back(std::move(task));
+        if (state->scheduled)
+            return;
+
+        state->scheduled = true;
+        executor         = state->executor;
+    }
+
+    schedule(state, *executor);
+}
+
+size_t DeliveryQueue::lane(std::string_view key) const noexcept
+{
+    return _lanes.size() == 1 ? 0 : std::hash<std::string_view>{}(key) % _lanes.size();
+}
+
+void DeliveryQueue::setSubscriptionId(int64_t id) noexcept
+{
+    _subscriptionId = id;
+}
+
+DeliveryStatistic DeliveryQueue::statistics() const
+{
+    DeliveryStatistic stats;
+    stats.subscriptionId = _subscriptionId;
+    stats.subject        = _subject;
+    stats.mode           = _mode;
+
+    for (auto&& state : _lanes)
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        stats.queuedMessages += state->tasks.size();
+        stats.callbackErrors += state->errors;
+    }
+
+    return stats;
+}
+
+std::vector<DeliveryStatistic> DeliveryQueue::allStatistics()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    std::vector<DeliveryStatistic> out;
+    out.reserve(registry().size());
+
+    for (auto&& queue : registry())
+        out.push_back(queue->statistics());
+
+    return out;
+}
+
+void DeliveryQueue::schedule(const std::shared_ptr<State>& state, Executor& executor)
+{
+    // The task holds the state, not the queue, so it is safe to run after the queue is destroyed
+    executor.execute([state] { runBatch(state); });
+}
+
+void DeliveryQueue::runBatch(const std::shared_ptr<State>& state)
+{
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+        Executor::Task task;
+
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->closed || state->tasks.empty())
+            {
+                state->scheduled = false;
+                return;
+            }
+
+            task = std::move(state->tasks.front());
+            state->tasks.pop_front();
+        }
+
+        // A throwing callback must neither stop the lane nor reach the executor thread
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            taskFailed(*state);
+        }
+    }
+
+    Executor* executor{ nullptr };
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed || state->tasks.empty())
+        {
+            state->scheduled = false;
+            return;
+        }
+
+        executor = state->executor;
+    }
+
+    // Let other subscriptions sharing the executor run before the next batch
+    schedule(state, *executor);
+}
+
+void DeliveryQueue::taskFailed(State& state)
+{
+    std::string text;
+
+    try
+    {
+        throw;
+    }
+    catch (const std::exception& exc)
+    {
+        text = exc.what();
+    }
+    catch (...)
+    {
+        text = "unknown error";
+    }
+
+    ErrorCb onError;
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ++state.errors;
+        onError = state.onError;
+    }
+
+    if (onError)
+        onError(Status::Error, "subscription callback failed: " + text);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Entities.h"
+#include "Executor.h"
+
+namespace NatsMq
+{
+    class WorkerPool;
+
+    //! Serial queue of subscription callbacks on top of an executor. Tasks are executed one at a time
+    //! in the posting order, even if the executor has several threads.
+    //! In the KeyOrdered mode the queue is split into lanes, each lane is serial on its own and lanes run in parallel.
+    class DeliveryQueue
+    {
+    public:
+        //! An exception thrown by a task is counted and passed to onError, the next tasks are still executed
+        DeliveryQueue(const DeliveryOptions& options, int64_t subscriptionId, std::string subject, ErrorCb onError = {});
+
+        //! Not executed tasks are dropped. A task already running on a user executor may still be finishing,
+        //! so the user executor must outlive the subscriptions using it.
+        ~DeliveryQueue();
+
+        void post(Executor::Task task);
+
+        //! Post to the lane of the key, see lane()
+        void post(size_t lane, Executor::Task task);
+
+        //! Lane of the key. Computed before the task is built, since the key usually points into the posted message.
+        size_t lane(std::string_view key) const noexcept;
+
+        //! For subscriptions created after the queue
+        void setSubscriptionId(int64_t id) noexcept;
+
+        DeliveryStatistic statistics() const;
+
+        //! Statistics of all living queues
+        static std::vector<DeliveryStatistic> allStatistics();
+
+    private:
+        struct State
+        {
+            std::mutex                 mutex;
+            std::deque<Executor::Task> tasks;
+            bool                       scheduled{ false };
+            bool                       closed{ false };
+            Executor*                  executor{ nullptr };
+            uint64_t                   errors{ 0 };
+            ErrorCb                    onError;
+        };
+
+        static void schedule(const std::shared_ptr<State>& state, Executor& executor);
+
+        static void runBatch(const std::shared_ptr<State>& state);
+
+        //! Called from a catch block
+        static void taskFailed(State& state);
+
+    private:
+        const DeliveryMode   _mode;
+        std::atomic<int64_t> _subscriptionId;
+        const std::string    _subject;
+
+        std::shared_ptr<Executor>           _executor;
+        std::unique_ptr<WorkerPool>         _dedicated;
+        std::vector<std::shared_ptr<State>> _lanes;
+    };
+}
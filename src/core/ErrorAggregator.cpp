@@ -0,0 +1,91 @@
+#include "ErrorAggregator.h"
+
+#include "Exceptions.h"
+
+using namespace NatsMq;
+
+ErrorAggregator::ErrorAggregator(int64_t windowMs, Sink sink)
+    : _window(windowMs)
+    , _sink(std::move(sink))
+{
+    if (windowMs <= 0 || !_sink)
+        throw Exception(Status::InvalidArg);
+
+    _timer = std::thread(&ErrorAggregator::run, this);
+}
+
+ErrorAggregator::~ErrorAggregator()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+
+    _cv.notify_one();
+    _timer.join();
+
+    flush();
+}
+
+void ErrorAggregator::record(Status status, natsSubscription* sub)
+{
+    const int64_t id = sub ? natsSubscription_GetID(sub) : 0;
+
+    // The dropped counter is cumulative, so the last value seen in the window is the total
+    int64_t dropped{ 0 };
+    if (sub)
+        natsSubscription_GetDropped(sub, &dropped);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto [it, inserted] = _pending.try_emplace({ id, status });
+    auto& report        = it->second;
+
+    if (inserted)
+    {
+        report.status         = status;
+        report.subscriptionId = id;
+        if (const char* subject = sub ? natsSubscription_GetSubject(sub) : nullptr)
+            report.subject = subject;
+    }
+
+    ++report.count;
+    report.droppedMessages = dropped;
+}
+
+void ErrorAggregator::flush()
+{
+    Reports reports;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        reports.swap(_pending);
+    }
+
+    for (auto&& [key, report] : reports)
+    {
+        report.text = natsStatus_GetText(static_cast<natsStatus>(report.status));
+        _sink(report);
+    }
+}
+
+void ErrorAggregator::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto last = Clock::now();
+
+    // The predicate and the absolute deadline keep a spurious wake up from reporting before the window ends
+    while (!_cv.wait_until(lock, last + _window, [this] { return _stopped; }))
+    {
+        last = Clock::now();
+        if (_pending.empty())
+            continue;
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <nats.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Entities.h"
+
+namespace NatsMq
+{
+    //! Coalesces asynchronous errors per subscription and status. The library thread only updates a counter,
+    //! reports are passed to the sink by the aggregator's own thread, at most one per pair and window.
+    class ErrorAggregator
+    {
+    public:
+        using Sink = std::function<void(const ErrorReport&)>;
+
+        ErrorAggregator(int64_t windowMs, Sink sink);
+
+        //! Errors still collected are reported
+        ~ErrorAggregator();
+
+        ErrorAggregator(const ErrorAggregator&) = delete;
+
+        ErrorAggregator& operator=(const ErrorAggregator&) = delete;
+
+        //! Called from the error handler, the subscription is valid only during the call
+        void record(Status status, natsSubscription* sub);
+
+    private:
+        using Key     = std::pair<int64_t, Status>;
+        using Reports = std::map<Key, ErrorReport>;
+
+        void flush();
+
+        void run();
+
+    private:
+        const std::chrono::milliseconds _window;
+        const Sink                      _sink;
+
+        std::mutex              _mutex;
+        std::condition_variable _cv;
+        Reports                 _pending;
+        bool                    _stopped{ false };
+
+        std::thread _timer;
+    };
+}
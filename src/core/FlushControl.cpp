@@ -0,0 +1,254 @@
+#include "FlushControl.h"
+
+#include "Exceptions.h"
+#include "Message.h"
+#include "core/Publisher.h"
+
+using namespace NatsMq;
+
+FlushControl::~FlushControl()
+{
+    stop();
+}
+
+void FlushControl::start(natsConnection* connection, const FlushPolicy& policy, ErrorSink sink)
+{
+    stop();
+
+    if (policy.maxBufferedBytes <= 0 && policy.maxDelayUs <= 0)
+        return;
+
+    // Without the delay trigger the tail of a burst would be held until the next publish
+    if (policy.maxDelayUs <= 0)
+        throw Exception(Status::InvalidArg);
+
+    _connection = connection;
+    _policy     = policy;
+    _sink       = std::move(sink);
+    _armed      = false;
+    _stopped    = false;
+    _batching   = true;
+    _flusher    = std::thread(&FlushControl::flusherLoop, this);
+}
+
+void FlushControl::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_flusherMutex);
+        _stopped = true;
+    }
+
+    _flusherCv.notify_all();
+
+    if (_flusher.joinable())
+        _flusher.join();
+
+    std::vector<Status> failed;
+
+    {
+        std::lock_guard<std::mutex> lock(_corkMutex);
+        _batching = false;
+
+        if (!_corked)
+            failed = publishHeld();
+    }
+
+    report(failed);
+    _connection = nullptr;
+}
+
+void FlushControl::cork()
+{
+    std::lock_guard<std::mutex> lock(_corkMutex);
+    _corked = true;
+}
+
+std::vector<Status> FlushControl::uncork(natsConnection* connection)
+{
+    // Messages are published under the lock, so concurrent publishers wait in hold() and can't overtake them
+    std::lock_guard<std::mutex> lock(_corkMutex);
+
+    auto statuses = sendHeld(connection);
+    _corked       = false;
+
+    return statuses;
+}
+
+bool FlushControl::isCorked() const noexcept
+{
+    return _corked;
+}
+
+bool FlushControl::isHolding() const noexcept
+{
+    return _corked || _batching;
+}
+
+bool FlushControl::hold(Message& msg)
+{
+    if (!isHolding())
+        return false;
+
+    std::unique_lock<std::mutex> lock(_corkMutex);
+    if (!isHolding())
+        return false;
+
+    const auto size = msg.data.size();
+    _holded.push_back({ std::move(msg) });
+
+    return held(lock, size);
+}
+
+bool FlushControl::hold(std::string_view subject, ByteSpan data)
+{
+    if (!isHolding())
+        return false;
+
+    std::unique_lock<std::mutex> lock(_corkMutex);
+    if (!isHolding())
+        return false;
+
+    Held msg;
+    msg.message.subject = std::string(subject);
+    msg.offset          = _payloads.size();
+    msg.size            = data.size;
+    msg.raw             = true;
+
+    _payloads.insert(_payloads.end(), data.begin(), data.end());
+    _holded.push_back(std::move(msg));
+
+    return held(lock, data.size);
+}
+
+bool FlushControl::held(std::unique_lock<std::mutex>& lock, size_t size)
+{
+    if (_corked)
+        return true;
+
+    _heldBytes += size;
+
+    const auto          first = _holded.size() == 1;
+    bool                released{ false };
+    std::vector<Status> failed;
+
+    // The publisher that fills the buffer releases it, the flusher thread only handles the delay
+    const auto maxBytes = static_cast<size_t>(_policy.maxBufferedBytes);
+    if (maxBytes && _heldBytes >= maxBytes)
+    {
+        failed   = publishHeld();
+        released = true;
+    }
+
+    lock.unlock();
+
+    if (first && !released)
+        arm();
+
+    report(failed);
+    return true;
+}
+
+void FlushControl::release()
+{
+    if (!_batching)
+        return;
+
+    std::vector<Status> failed;
+
+    {
+        std::lock_guard<std::mutex> lock(_corkMutex);
+        if (_corked)
+            return;
+
+        failed = publishHeld();
+    }
+
+    report(failed);
+}
+
+std::vector<Status> FlushControl::sendHeld(natsConnection* connection)
+{
+    std::vector<Status> statuses;
+    statuses.reserve(_holded.size());
+
+    // All messages land in the cnats buffer at once, so they leave in as few writes as possible
+    Publisher publisher(connection);
+    for (auto&& held : _holded)
+    {
+        if (held.raw)
+            statuses.push_back(publisher.tryPublish(RawMessage{ held.message.subject, { _payloads.data() + held.offset, held.size } }));
+        else
+            statuses.push_back(publisher.tryPublish(held.message));
+    }
+
+    // The buffers keep their capacity for the next burst
+    _holded.clear();
+    _payloads.clear();
+    _heldBytes = 0;
+
+    return statuses;
+}
+
+std::vector<Status> FlushControl::publishHeld()
+{
+    std::vector<Status> failed;
+    if (_holded.empty())
+        return failed;
+
+    for (auto&& status : sendHeld(_connection))
+    {
+        if (status != Status::Ok)
+            failed.push_back(status);
+    }
+
+    return failed;
+}
+
+void FlushControl::report(const std::vector<Status>& failed) const
+{
+    if (!_sink)
+        return;
+
+    for (auto&& status : failed)
+        _sink(status);
+}
+
+void FlushControl::arm()
+{
+    {
+        std::lock_guard<std::mutex> lock(_flusherMutex);
+        if (_stopped || _armed)
+            return;
+
+        _deadline = Clock::now() + std::chrono::microseconds(_policy.maxDelayUs);
+        _armed    = true;
+    }
+
+    _flusherCv.notify_one();
+}
+
+void FlushControl::flusherLoop()
+{
+    std::unique_lock<std::mutex> lock(_flusherMutex);
+
+    while (!_stopped)
+    {
+        if (!_armed)
+        {
+            _flusherCv.wait(lock);
+            continue;
+        }
+
+        if (Clock::now() < _deadline)
+        {
+            _flusherCv.wait_until(lock, _deadline);
+            continue;
+        }
+
+        _armed = false;
+
+        lock.unlock();
+        release();
+        lock.lock();
+    }
+}
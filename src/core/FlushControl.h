@@ -0,0 +1,100 @@
+#pragma once
+
+#include <nats.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Entities.h"
+#include "Message.h"
+
+namespace NatsMq
+{
+    //! Controls when outbound data reaches the cnats buffer: holds messages while the connection is corked
+    //! and, with the adaptive flush policy, collects published messages and releases them in bursts.
+    //! cnats sends its buffer as soon as something is published and has no way to write it without a PING,
+    //! so the only way to batch the data is to hold it in the wrapper.
+    class FlushControl
+    {
+    public:
+        //! Receives statuses of held messages that failed to publish on release
+        using ErrorSink = std::function<void(Status)>;
+
+        FlushControl() = default;
+
+        ~FlushControl();
+
+        void start(natsConnection* connection, const FlushPolicy& policy, ErrorSink sink);
+
+        //! Held messages are published unless the connection is corked
+        void stop();
+
+        void cork();
+
+        std::vector<Status> uncork(natsConnection* connection);
+
+        bool isCorked() const noexcept;
+
+        //! True if published messages are held, by cork() or by the flush policy
+        bool isHolding() const noexcept;
+
+        //! Take the message if it must be held. Returns false if the message must be published right away.
+        bool hold(Message& msg);
+
+        //! Same for a message without headers, the payload is copied into a buffer reused between bursts
+        bool hold(std::string_view subject, ByteSpan data);
+
+        //! Publish messages held by the flush policy, does nothing while the connection is corked
+        void release();
+
+    private:
+        struct Held
+        {
+            Message message;     ///< Only the subject is set for a raw message
+            size_t  offset{ 0 }; ///< Raw payload position in _payloads
+            size_t  size{ 0 };   ///< Raw payload size
+            bool    raw{ false };
+        };
+
+        //! Called with the message just pushed, unlocks the lock
+        bool held(std::unique_lock<std::mutex>& lock, size_t size);
+
+        //! Must be called with _corkMutex locked, returns the status of every held message
+        std::vector<Status> sendHeld(natsConnection* connection);
+
+        //! Must be called with _corkMutex locked, returns failed statuses
+        std::vector<Status> publishHeld();
+
+        void report(const std::vector<Status>& failed) const;
+
+        void arm();
+
+        void flusherLoop();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::atomic<bool>    _corked{ false };
+        std::atomic<bool>    _batching{ false };
+        std::mutex           _corkMutex;
+        std::vector<Held>    _holded;
+        std::vector<uint8_t> _payloads;
+        size_t               _heldBytes{ 0 };
+
+        natsConnection*         _connection{ nullptr };
+        FlushPolicy             _policy;
+        ErrorSink               _sink;
+        bool                    _armed{ false };
+        bool                    _stopped{ true };
+        Clock::time_point       _deadline;
+        std::mutex              _flusherMutex;
+        std::condition_variable _flusherCv;
+        std::thread             _flusher;
+    };
+}
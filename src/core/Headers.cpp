@@ -0,0 +1,203 @@
+#include "Headers.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace NatsMq;
+
+namespace
+{
+    bool iequals(std::string_view a, std::string_view b) noexcept
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+Headers::const_iterator::const_iterator(const Headers* headers, size_t idx)
+    : _headers(headers)
+    , _idx(idx)
+{
+}
+
+Headers::Field Headers::const_iterator::operator*() const
+{
+    return _headers->field(_headers->_entries[_idx]);
+}
+
+Headers::const_iterator& Headers::const_iterator::operator++()
+{
+    ++_idx;
+    return *this;
+}
+
+Headers::const_iterator Headers::const_iterator::operator++(int)
+{
+    auto tmp = *this;
+    ++_idx;
+    return tmp;
+}
+
+bool Headers::const_iterator::operator==(const const_iterator& other) const noexcept
+{
+    return _headers == other._headers && _idx == other._idx;
+}
+
+bool Headers::const_iterator::operator!=(const const_iterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+Headers::Headers(std::initializer_list<std::pair<std::string, std::string>> fields)
+{
+    for (auto&& f : fields)
+        add(f.first, f.second);
+}
+
+std::string_view Headers::get(std::string_view key) const
+{
+    for (auto&& e : _entries)
+    {
+        const auto f = field(e);
+        if (iequals(f.first, key))
+            return f.second;
+    }
+
+    return {};
+}
+
+std::vector<std::string_view> Headers::values(std::string_view key) const
+{
+    std::vector<std::string_view> result;
+    for (auto&& e : _entries)
+    {
+        const auto f = field(e);
+        if (iequals(f.first, key))
+            result.push_back(f.second);
+    }
+
+    return result;
+}
+
+bool Headers::contains(std::string_view key) const
+{
+    return std::any_of(_entries.cbegin(), _entries.cend(), [this, key](const Entry& e) { return iequals(field(e).first, key); });
+}
+
+void Headers::add(std::string_view key, std::string_view value)
+{
+    _entries.push_back(append(key, value));
+}
+
+void Headers::set(std::string_view key, std::string_view value)
+{
+    remove(key);
+    add(key, value);
+}
+
+void Headers::remove(std::string_view key)
+{
+    const auto it = std::remove_if(_entries.begin(), _entries.end(), [this, key](const Entry& e) { return iequals(field(e).first, key); });
+    if (it == _entries.end())
+        return;
+
+    _entries.erase(it, _entries.end());
+    compact();
+}
+
+void Headers::clear() noexcept
+{
+    _buffer.clear();
+    _entries.clear();
+}
+
+size_t Headers::size() const
+{
+    return _entries.size();
+}
+
+bool Headers::empty() const
+{
+    return size() == 0;
+}
+
+Headers::const_iterator Headers::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+Headers::const_iterator Headers::end() const
+{
+    return const_iterator(this, _entries.size());
+}
+
+bool Headers::operator==(const Headers& other) const
+{
+    if (size() != other.size())
+        return false;
+
+    std::vector<Field> lhs(begin(), end());
+    std::vector<Field> rhs(other.begin(), other.end());
+
+    // Stable sort keeps the order of values inside one key
+    std::stable_sort(lhs.begin(), lhs.end(), [](const Field& a, const Field& b) { return a.first < b.first; });
+    std::stable_sort(rhs.begin(), rhs.end(), [](const Field& a, const Field& b) { return a.first < b.first; });
+
+    return lhs == rhs;
+}
+
+bool Headers::operator!=(const Headers& other) const
+{
+    return !(*this == other);
+}
+
+Headers::Entry Headers::append(std::string_view key, std::string_view value)
+{
+    Entry entry;
+
+    entry.keyOffset = static_cast<uint32_t>(_buffer.size());
+    entry.keyLength = static_cast<uint32_t>(key.size());
+    _buffer.append(key);
+
+    entry.valueOffset = static_cast<uint32_t>(_buffer.size());
+    entry.valueLength = static_cast<uint32_t>(value.size());
+    _buffer.append(value);
+
+    return entry;
+}
+
+Headers::Field Headers::field(const Entry& entry) const noexcept
+{
+    const std::string_view buffer(_buffer);
+    return { buffer.substr(entry.keyOffset, entry.keyLength), buffer.substr(entry.valueOffset, entry.valueLength) };
+}
+
+void Headers::compact()
+{
+    size_t used{ 0 };
+    for (auto&& e : _entries)
+        used += e.keyLength + e.valueLength;
+
+    // Removed fields leave holes in the buffer, rebuild it only if they take the most of the space
+    if (used * 2 >= _buffer.size())
+        return;
+
+    std::string buffer;
+    buffer.reserve(used);
+
+    std::swap(buffer, _buffer);
+
+    for (auto&& e : _entries)
+    {
+        const std::string_view old(buffer);
+        e = append(old.substr(e.keyOffset, e.keyLength), old.substr(e.valueOffset, e.valueLength));
+    }
+}
@@ -0,0 +1,16 @@
+#include "KeyExtractors.h"
+
+#include "Message.h"
+#include "Subject.h"
+
+using namespace NatsMq;
+
+KeyExtractor KeyExtractors::subjectToken(int index)
+{
+    return [index](const Message& msg) { return Subjects::token(msg.subject, index); };
+}
+
+KeyExtractor KeyExtractors::header(std::string name)
+{
+    return [name = std::move(name)](const Message& msg) { return msg.headers.get(name); };
+}
@@ -0,0 +1,125 @@
+#include "MessageBatcher.h"
+
+#include "Exceptions.h"
+
+using namespace NatsMq;
+
+MessageBatcher::MessageBatcher(size_t maxBatch, uint64_t maxLatencyMs, SubscriptionBatchCb cb, ErrorCb onError)
+    : _maxBatch(maxBatch)
+    , _maxLatency(maxLatencyMs)
+    , _cb(std::move(cb))
+    , _onError(std::move(onError))
+{
+    if (!_maxBatch || !_cb)
+        throw Exception(Status::InvalidArg);
+
+    _pending.reserve(_maxBatch);
+    _batch.reserve(_maxBatch);
+
+    _timer = std::thread(&MessageBatcher::run, this);
+}
+
+MessageBatcher::~MessageBatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+
+    _cv.notify_one();
+    _timer.join();
+
+    flush();
+}
+
+void MessageBatcher::push(Message msg)
+{
+    bool full{ false };
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.push_back(std::move(msg));
+
+        if (_pending.size() == 1)
+        {
+            _deadline = Clock::now() + _maxLatency;
+            _cv.notify_one();
+        }
+
+        full = _pending.size() >= _maxBatch;
+    }
+
+    if (full)
+        flush();
+}
+
+void MessageBatcher::flush()
+{
+    std::lock_guard<std::mutex> flushLock(_flushMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_pending.empty())
+            return;
+
+        // _batch is empty here, so the swap also hands its capacity back to the collector
+        _pending.swap(_batch);
+    }
+
+    // The handler runs on the timer thread or in the destructor, an exception must not terminate the process
+    try
+    {
+        _cb(_batch);
+    }
+    catch (...)
+    {
+        handlerFailed();
+    }
+
+    _batch.clear();
+}
+
+void MessageBatcher::handlerFailed() const
+{
+    std::string text;
+
+    try
+    {
+        throw;
+    }
+    catch (const std::exception& exc)
+    {
+        text = exc.what();
+    }
+    catch (...)
+    {
+        text = "unknown error";
+    }
+
+    if (_onError)
+        _onError(Status::Error, "subscription batch callback failed: " + text);
+}
+
+void MessageBatcher::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_stopped)
+    {
+        if (_pending.empty())
+        {
+            _cv.wait(lock);
+            continue;
+        }
+
+        if (Clock::now() < _deadline)
+        {
+            _cv.wait_until(lock, _deadline);
+            continue;
+        }
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Entities.h"
+#include "Message.h"
+
+namespace NatsMq
+{
+    //! Collects delivered messages and passes them to the handler in batches. A batch is flushed by the delivery thread
+    //! once it is full, or by the batcher's own thread when the oldest message has waited for maxLatency.
+    //! The handler is invoked one batch at a time, always with the same vector, so its capacity is reused.
+    //! An exception thrown by the handler is passed to onError, the batch is dropped.
+    class MessageBatcher
+    {
+    public:
+        MessageBatcher(size_t maxBatch, uint64_t maxLatencyMs, SubscriptionBatchCb cb, ErrorCb onError = {});
+
+        //! Messages still collected are flushed to the handler
+        ~MessageBatcher();
+
+        MessageBatcher(const MessageBatcher&) = delete;
+
+        MessageBatcher& operator=(const MessageBatcher&) = delete;
+
+        void push(Message msg);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void flush();
+
+        //! Called from the catch block of the failed handler
+        void handlerFailed() const;
+
+        void run();
+
+    private:
+        const size_t                    _maxBatch;
+        const std::chrono::milliseconds _maxLatency;
+        const SubscriptionBatchCb       _cb;
+        const ErrorCb                   _onError;
+
+        std::mutex              _mutex;
+        std::condition_variable _cv;
+        std::vector<Message>    _pending;
+        Clock::time_point       _deadline;
+        bool                    _stopped{ false };
+
+        //! Serializes handler calls, taken before _mutex
+        std::mutex           _flushMutex;
+        std::vector<Message> _batch;
+
+        std::thread _timer;
+    };
+}
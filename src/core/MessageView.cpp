@@ -0,0 +1,57 @@
+#include "MessageView.h"
+
+#include "Message.h"
+#include "MessageViewPrivate.h"
+
+using namespace NatsMq;
+
+MessageView::MessageView(const MessageViewPrivate* impl)
+    : _impl(impl)
+{
+}
+
+std::string_view MessageView::subject() const noexcept
+{
+    return _impl->subject();
+}
+
+std::string_view MessageView::replySubject() const noexcept
+{
+    return _impl->replySubject();
+}
+
+ByteSpan MessageView::data() const noexcept
+{
+    return _impl->data();
+}
+
+MessageView::operator std::string_view() const noexcept
+{
+    const auto bytes = data();
+    return std::string_view(reinterpret_cast<const char*>(bytes.data), bytes.size);
+}
+
+bool MessageView::isEmpty() const noexcept
+{
+    return _impl->isEmpty();
+}
+
+std::string_view MessageView::header(const std::string& key) const
+{
+    return _impl->header(key);
+}
+
+std::vector<std::string_view> MessageView::headerValues(const std::string& key) const
+{
+    return _impl->headerValues(key);
+}
+
+std::vector<std::string_view> MessageView::headerKeys() const
+{
+    return _impl->headerKeys();
+}
+
+Message MessageView::toMessage() const
+{
+    return _impl->toMessage();
+}
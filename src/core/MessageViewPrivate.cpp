@@ -0,0 +1,109 @@
+#include "MessageViewPrivate.h"
+
+#include "Exceptions.h"
+#include "Message.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+namespace
+{
+    std::string_view viewIfNotNull(const char* s)
+    {
+        return s ? std::string_view(s) : std::string_view();
+    }
+
+    std::vector<std::string_view> toViews(const char** array, int count)
+    {
+        std::vector<std::string_view> views;
+        views.reserve(count);
+
+        for (auto i = 0; i < count; ++i)
+            views.emplace_back(array[i]);
+
+        free((void*)array);
+        return views;
+    }
+}
+
+MessageViewPrivate::MessageViewPrivate(natsMsg* msg)
+    : _msg(msg)
+{
+}
+
+std::string_view MessageViewPrivate::subject() const noexcept
+{
+    return _msg ? viewIfNotNull(natsMsg_GetSubject(_msg)) : std::string_view();
+}
+
+std::string_view MessageViewPrivate::replySubject() const noexcept
+{
+    return _msg ? viewIfNotNull(natsMsg_GetReply(_msg)) : std::string_view();
+}
+
+ByteSpan MessageViewPrivate::data() const noexcept
+{
+    if (!_msg)
+        return {};
+
+    const auto dataPtr = reinterpret_cast<const uint8_t*>(natsMsg_GetData(_msg));
+    const auto dataLen = static_cast<size_t>(natsMsg_GetDataLength(_msg));
+
+    return { dataPtr, dataLen };
+}
+
+bool MessageViewPrivate::isEmpty() const noexcept
+{
+    return !_msg;
+}
+
+std::string_view MessageViewPrivate::header(const std::string& key) const
+{
+    if (!_msg)
+        return {};
+
+    const char* value{ nullptr };
+    const auto  status = natsMsgHeader_Get(_msg, key.c_str(), &value);
+    if (status == NATS_NOT_FOUND)
+        return {};
+
+    exceptionIfError(status);
+    return viewIfNotNull(value);
+}
+
+std::vector<std::string_view> MessageViewPrivate::headerValues(const std::string& key) const
+{
+    if (!_msg)
+        return {};
+
+    const char** values{ nullptr };
+    int          count{ 0 };
+
+    const auto status = natsMsgHeader_Values(_msg, key.c_str(), &values, &count);
+    if (status == NATS_NOT_FOUND)
+        return {};
+
+    exceptionIfError(status);
+    return toViews(values, count);
+}
+
+std::vector<std::string_view> MessageViewPrivate::headerKeys() const
+{
+    if (!_msg)
+        return {};
+
+    const char** keys{ nullptr };
+    int          count{ 0 };
+
+    const auto status = natsMsgHeader_Keys(_msg, &keys, &count);
+    if (status == NATS_NOT_FOUND)
+        return {};
+
+    exceptionIfError(status);
+    return toViews(keys, count);
+}
+
+Message MessageViewPrivate::toMessage() const
+{
+    return fromCnatsMessage(_msg);
+}
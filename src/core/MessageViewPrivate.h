@@ -0,0 +1,37 @@
+#pragma once
+
+#include <nats.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Entities.h"
+
+namespace NatsMq
+{
+    class MessageViewPrivate
+    {
+    public:
+        MessageViewPrivate(natsMsg* msg);
+
+        std::string_view subject() const noexcept;
+
+        std::string_view replySubject() const noexcept;
+
+        ByteSpan data() const noexcept;
+
+        bool isEmpty() const noexcept;
+
+        std::string_view header(const std::string& key) const;
+
+        std::vector<std::string_view> headerValues(const std::string& key) const;
+
+        std::vector<std::string_view> headerKeys() const;
+
+        Message toMessage() const;
+
+    private:
+        natsMsg* _msg;
+    };
+}
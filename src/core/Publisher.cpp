@@ -6,6 +6,21 @@
 
 using namespace NatsMq;
 
+namespace
+{
+    template <typename T, typename Func>
+    std::vector<Status> publishEach(const T* msgs, size_t count, Func&& func)
+    {
+        std::vector<Status> statuses;
+        statuses.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+            statuses.push_back(func(msgs[i]));
+
+        return statuses;
+    }
+}
+
 Publisher::Publisher(natsConnection* connection)
     : _connection(connection)
 {
@@ -13,11 +28,83 @@ Publisher::Publisher(natsConnection* connection)
 
 void Publisher::publish(Message msg) const
 {
-    const auto cnatsMsg = createCnatsMessage(msg);
-    exceptionIfError(natsConnection_PublishMsg(_connection, cnatsMsg.get()));
+    exceptionIfError(tryPublish(msg));
 }
 
 void Publisher::publish(std::string subject, std::string data) const
 {
     exceptionIfError(natsConnection_PublishString(_connection, subject.c_str(), data.c_str()));
 }
+
+void Publisher::publish(std::string_view subject, const void* data, size_t size) const
+{
+    exceptionIfError(tryPublish(RawMessage{ subject, { static_cast<const uint8_t*>(data), size } }));
+}
+
+std::vector<Status> Publisher::publishBatch(const Message* msgs, size_t count, int64_t flushTimeoutMs) const
+{
+    auto statuses = publishEach(msgs, count, [this](const Message& msg) { return tryPublish(msg); });
+    flush(flushTimeoutMs);
+    return statuses;
+}
+
+std::vector<Status> Publisher::publishBatch(const RawMessage* msgs, size_t count, int64_t flushTimeoutMs) const
+{
+    auto statuses = publishEach(msgs, count, [this](const RawMessage& msg) { return tryPublish(msg); });
+    flush(flushTimeoutMs);
+    return statuses;
+}
+
+void Publisher::flush(int64_t timeoutMs) const
+{
+    if (timeoutMs >= 0)
+        exceptionIfError(natsConnection_FlushTimeout(_connection, timeoutMs));
+}
+
+Status Publisher::tryPublish(const Message& msg) const noexcept
+{
+    try
+    {
+        const auto dataSize = checkedDataSize(msg.data.size());
+
+        // Messages without headers don't need an intermediate cnats message
+        if (msg.headers.empty() && msg.replySubject.empty())
+            return static_cast<Status>(natsConnection_Publish(_connection, msg.subject.c_str(), msg.data.data(), dataSize));
+
+        if (msg.headers.empty())
+            return static_cast<Status>(natsConnection_PublishRequest(_connection, msg.subject.c_str(), msg.replySubject.c_str(), msg.data.data(), dataSize));
+
+        const auto cnatsMsg = createCnatsMessage(msg);
+        return static_cast<Status>(natsConnection_PublishMsg(_connection, cnatsMsg.get()));
+    }
+    catch (const Exception& exc)
+    {
+        return exc.status;
+    }
+    catch (...)
+    {
+        // Copying the message can throw std::bad_alloc, which must not leave the noexcept function
+        return Status::Error;
+    }
+}
+
+Status Publisher::tryPublish(const RawMessage& msg) const noexcept
+{
+    try
+    {
+        const auto dataSize = checkedDataSize(msg.data.size);
+
+        return withCString(msg.subject, [this, &msg, dataSize](const char* subj) {
+            return static_cast<Status>(natsConnection_Publish(_connection, subj, msg.data.data, dataSize));
+        });
+    }
+    catch (const Exception& exc)
+    {
+        return exc.status;
+    }
+    catch (...)
+    {
+        // A long subject is copied to the heap
+        return Status::Error;
+    }
+}
@@ -3,6 +3,10 @@
 #include <nats.h>
 
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "Entities.h"
 
 namespace NatsMq
 {
@@ -17,6 +21,19 @@ namespace NatsMq
 
         void publish(std::string subject, std::string data) const;
 
+        void publish(std::string_view subject, const void* data, size_t size) const;
+
+        std::vector<Status> publishBatch(const Message* msgs, size_t count, int64_t flushTimeoutMs) const;
+
+        std::vector<Status> publishBatch(const RawMessage* msgs, size_t count, int64_t flushTimeoutMs) const;
+
+        void flush(int64_t timeoutMs) const;
+
+        //! Publish the message and return the status instead of throwing
+        Status tryPublish(const Message& msg) const noexcept;
+
+        Status tryPublish(const RawMessage& msg) const noexcept;
+
     private:
         natsConnection* _connection;
     };
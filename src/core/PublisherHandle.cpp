@@ -0,0 +1,42 @@
+#include "PublisherHandle.h"
+
+#include "Headers.h"
+#include "PublisherHandlePrivate.h"
+
+using namespace NatsMq;
+
+PublisherHandle::PublisherHandle(PublisherHandlePrivate* impl)
+    : _impl(impl)
+{
+}
+
+PublisherHandle::~PublisherHandle() = default;
+
+PublisherHandle::PublisherHandle(PublisherHandle&&) = default;
+
+PublisherHandle& PublisherHandle::operator=(PublisherHandle&&) = default;
+
+std::string PublisherHandle::subject() const noexcept
+{
+    return _impl->subject();
+}
+
+void PublisherHandle::publish(const void* data, size_t size) const
+{
+    _impl->publish(data, size);
+}
+
+void PublisherHandle::publish(ByteSpan data) const
+{
+    _impl->publish(data.data, data.size);
+}
+
+void PublisherHandle::publish(ByteSpan data, const Headers& headers) const
+{
+    _impl->publish(data, headers);
+}
+
+void PublisherHandle::publish(std::string_view suffix, ByteSpan data) const
+{
+    _impl->publish(suffix, data);
+}
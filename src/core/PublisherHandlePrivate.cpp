@@ -0,0 +1,103 @@
+#include "PublisherHandlePrivate.h"
+
+#include <cstring>
+
+#include "Exceptions.h"
+#include "Headers.h"
+#include "Message.h"
+#include "Subject.h"
+#include "core/Connection.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+PublisherHandlePrivate::PublisherHandlePrivate(std::shared_ptr<Connection> connection, std::string subject)
+    : _connection(std::move(connection))
+    , _subject(std::move(subject))
+{
+    if (!Subjects::isValid(_subject))
+        exceptionIfError(Status::InvalidSubject);
+}
+
+PublisherHandlePrivate::PublisherHandlePrivate(std::shared_ptr<Connection> connection, const Subject& subject)
+    : _connection(std::move(connection))
+    , _subject(subject.str())
+{
+    if (subject.isPattern())
+        exceptionIfError(Status::InvalidSubject);
+}
+
+const std::string& PublisherHandlePrivate::subject() const noexcept
+{
+    return _subject;
+}
+
+void PublisherHandlePrivate::publish(const void* data, size_t size) const
+{
+    if (tryHold(_subject, { static_cast<const uint8_t*>(data), size }, {}))
+        return;
+
+    exceptionIfError(natsConnection_Publish(_connection->rawConnection(), _subject.c_str(), data, checkedDataSize(size)));
+}
+
+void PublisherHandlePrivate::publish(ByteSpan data, const Headers& headers) const
+{
+    if (headers.empty())
+        return publish(data.data, data.size);
+
+    if (tryHold(_subject, data, headers))
+        return;
+
+    natsMsg*   cnatsMsg{ nullptr };
+    const auto dataPtr = reinterpret_cast<const char*>(data.data);
+
+    exceptionIfError(natsMsg_Create(&cnatsMsg, _subject.c_str(), nullptr, dataPtr, checkedDataSize(data.size)));
+
+    NatsMsgPtr msg(cnatsMsg, &natsMsg_Destroy);
+
+    addCnatsHeaders(cnatsMsg, headers);
+
+    exceptionIfError(natsConnection_PublishMsg(_connection->rawConnection(), cnatsMsg));
+}
+
+void PublisherHandlePrivate::publish(std::string_view suffix, ByteSpan data) const
+{
+    if (!Subjects::isValid(suffix))
+        exceptionIfError(Status::InvalidSubject);
+
+    if (_connection->flushControl().isHolding() && tryHold(_subject + '.' + std::string(suffix), data, {}))
+        return;
+
+    const auto publishTo = [this, data](const char* subject) {
+        exceptionIfError(natsConnection_Publish(_connection->rawConnection(), subject, data.data, checkedDataSize(data.size)));
+    };
+
+    constexpr size_t stackSize{ 256 };
+
+    const auto length = _subject.size() + 1 + suffix.size();
+    if (length >= stackSize)
+        return publishTo((_subject + '.' + std::string(suffix)).c_str());
+
+    char buffer[stackSize];
+    std::memcpy(buffer, _subject.data(), _subject.size());
+    buffer[_subject.size()] = '.';
+    std::memcpy(buffer + _subject.size() + 1, suffix.data(), suffix.size());
+    buffer[length] = '\0';
+
+    publishTo(buffer);
+}
+
+bool PublisherHandlePrivate::tryHold(std::string_view subject, ByteSpan data, const Headers& headers) const
+{
+    auto& control = _connection->flushControl();
+    if (!control.isHolding())
+        return false;
+
+    if (headers.empty())
+        return control.hold(subject, data);
+
+    Message msg(std::string(subject), std::vector<uint8_t>(data.begin(), data.end()));
+    msg.headers = headers;
+
+    return control.hold(msg);
+}
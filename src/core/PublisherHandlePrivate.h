@@ -0,0 +1,40 @@
+#pragma once
+
+#include <nats.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Entities.h"
+
+namespace NatsMq
+{
+    class Connection;
+    class Headers;
+    class Subject;
+
+    class PublisherHandlePrivate
+    {
+    public:
+        PublisherHandlePrivate(std::shared_ptr<Connection> connection, std::string subject);
+
+        //! The subject is already validated
+        PublisherHandlePrivate(std::shared_ptr<Connection> connection, const Subject& subject);
+
+        const std::string& subject() const noexcept;
+
+        void publish(const void* data, size_t size) const;
+
+        void publish(ByteSpan data, const Headers& headers) const;
+
+        void publish(std::string_view suffix, ByteSpan data) const;
+
+    private:
+        bool tryHold(std::string_view subject, ByteSpan data, const Headers& headers) const;
+
+    private:
+        std::shared_ptr<Connection> _connection;
+        std::string                 _subject;
+    };
+}
@@ -0,0 +1,157 @@
+#include "ReplyCache.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "Exceptions.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+namespace
+{
+    constexpr int64_t drainTimeoutMs{ 1000 };
+}
+
+ReplyCache::ReplyCache(natsConnection* connection, const ReplyCacheOptions& options)
+    : _options(options)
+    , _shardCapacity(std::max<size_t>(1, options.maxEntries / std::max<size_t>(1, options.shards)))
+    , _shards(std::max<size_t>(1, options.shards))
+    , _invalidationSub(nullptr, &natsSubscription_Destroy)
+{
+    if (options.invalidationSubject.empty())
+        return;
+
+    natsSubscription* sub{ nullptr };
+    exceptionIfError(natsConnection_Subscribe(&sub, connection, options.invalidationSubject.c_str(), &ReplyCache::invalidationCallback, this));
+    _invalidationSub.reset(sub);
+}
+
+ReplyCache::~ReplyCache()
+{
+    // Wait until the invalidation callback in progress is finished, it references this object
+    if (_invalidationSub && natsSubscription_Drain(_invalidationSub.get()) == NATS_OK)
+        natsSubscription_WaitForDrainCompletion(_invalidationSub.get(), drainTimeoutMs);
+}
+
+std::optional<Message> ReplyCache::get(const std::string& key)
+{
+    auto& shard = shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto it = shard.index.find(key);
+    if (it == shard.index.end())
+        return std::nullopt;
+
+    const auto entry = it->second;
+    if (entry->expiresAt <= Clock::now())
+    {
+        shard.index.erase(it);
+        shard.lru.erase(entry);
+        return std::nullopt;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+
+    return entry->reply;
+}
+
+uint64_t ReplyCache::generation(const std::string& key) const noexcept
+{
+    return _allGeneration + generationSlot(std::string_view(key).substr(0, key.find(' ')));
+}
+
+void ReplyCache::put(std::string key, const Message& reply, uint64_t generation)
+{
+    auto&      shard     = shardFor(key);
+    const auto expiresAt = Clock::now() + std::chrono::milliseconds(ttlFor(key));
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // invalidate() bumps the generation before it evicts under the shard lock, so a stale reply is either dropped here or evicted there
+    if (this->generation(key) != generation)
+        return;
+
+    const auto it = shard.index.find(key);
+    if (it != shard.index.end())
+    {
+        it->second->reply     = reply;
+        it->second->expiresAt = expiresAt;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    if (shard.lru.size() >= _shardCapacity)
+    {
+        shard.index.erase(shard.lru.back().key);
+        shard.lru.pop_back();
+    }
+
+    // The index refers to the key stored in the list node, list nodes never move
+    shard.lru.push_front(Entry{ std::move(key), reply, expiresAt });
+    shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+}
+
+void ReplyCache::invalidate(std::string_view subject)
+{
+    if (subject.empty())
+        ++_allGeneration;
+    else
+        ++generationSlot(subject);
+
+    for (auto&& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        if (subject.empty())
+        {
+            shard.index.clear();
+            shard.lru.clear();
+            continue;
+        }
+
+        for (auto it = shard.lru.begin(); it != shard.lru.end();)
+        {
+            const std::string_view key(it->key);
+            if (key.size() > subject.size() && key[subject.size()] == ' ' && key.substr(0, subject.size()) == subject)
+            {
+                shard.index.erase(key);
+                it = shard.lru.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+bool ReplyCache::isCacheable(const Message& request) noexcept
+{
+    return request.headers.empty();
+}
+
+ReplyCache::Shard& ReplyCache::shardFor(const std::string& key)
+{
+    return _shards[std::hash<std::string>{}(key) % _shards.size()];
+}
+
+int64_t ReplyCache::ttlFor(std::string_view key) const
+{
+    const auto it = _options.subjectTtlMs.find(std::string(key.substr(0, key.find(' '))));
+    return it != _options.subjectTtlMs.end() ? it->second : _options.ttlMs;
+}
+
+std::atomic<uint64_t>& ReplyCache::generationSlot(std::string_view subject) const noexcept
+{
+    return _generations[std::hash<std::string_view>{}(subject) % generationSlots];
+}
+
+void ReplyCache::invalidationCallback(natsConnection*, natsSubscription*, natsMsg* msg, void* closure)
+{
+    NatsMsgPtr ptr(msg, &natsMsg_Destroy);
+
+    const auto cache = reinterpret_cast<ReplyCache*>(closure);
+    cache->invalidate(std::string_view(natsMsg_GetData(msg), natsMsg_GetDataLength(msg)));
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <nats.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Entities.h"
+#include "Message.h"
+#include "private/defines.h"
+
+namespace NatsMq
+{
+    //! Sharded LRU cache of request replies with TTL. Requests are identified by subject and payload.
+    class ReplyCache
+    {
+    public:
+        ReplyCache(natsConnection* connection, const ReplyCacheOptions& options);
+
+        ~ReplyCache();
+
+        //! Cached reply of the request if it is present and not expired. The key is made by requestKey()
+        std::optional<Message> get(const std::string& key);
+
+        //! Invalidation generation of the request subject, taken before the request is sent
+        uint64_t generation(const std::string& key) const noexcept;
+
+        //! The reply is dropped if the subject was invalidated after the generation was taken,
+        //! otherwise a reply that was in flight during the invalidation would be served until its TTL expires
+        void put(std::string key, const Message& reply, uint64_t generation);
+
+        //! Evict replies to the request subject, empty subject evicts everything
+        void invalidate(std::string_view subject);
+
+        //! Requests with headers are never cached
+        static bool isCacheable(const Message& request) noexcept;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry
+        {
+            std::string       key;
+            Message           reply;
+            Clock::time_point expiresAt;
+        };
+
+        struct Shard
+        {
+            std::mutex                                                        mutex;
+            std::list<Entry>                                                  lru; ///< Most recently used first
+            std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+        };
+
+        Shard& shardFor(const std::string& key);
+
+        int64_t ttlFor(std::string_view key) const;
+
+        std::atomic<uint64_t>& generationSlot(std::string_view subject) const noexcept;
+
+        static void invalidationCallback(natsConnection* nc, natsSubscription* sub, natsMsg* msg, void* closure);
+
+    private:
+        ReplyCacheOptions  _options;
+        size_t             _shardCapacity;
+        std::vector<Shard> _shards;
+
+        //! Subjects are hashed to a fixed number of counters, a collision only drops a reply that could be cached.
+        //! The generation of a subject is the sum of its counter and the counter of invalidations of everything.
+        static constexpr size_t                                     generationSlots{ 64 };
+        mutable std::array<std::atomic<uint64_t>, generationSlots> _generations{};
+        std::atomic<uint64_t>                                       _allGeneration{ 0 };
+
+        NatsSubscriptionPtr _invalidationSub;
+    };
+}
@@ -0,0 +1,58 @@
+#include "RequestCoalescer.h"
+
+#include "Exceptions.h"
+#include "core/ResponseMux.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+void RequestCoalescer::request(ResponseMux& mux, Message msg, uint64_t timeoutMs, RequestCb cb)
+{
+    if (!msg.headers.empty())
+        return mux.request(std::move(msg), timeoutMs, std::move(cb));
+
+    auto key = requestKey(msg);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto [it, inserted] = _flights.try_emplace(key);
+        it->second.push_back(std::move(cb));
+
+        if (!inserted)
+            return;
+    }
+
+    try
+    {
+        mux.request(std::move(msg), timeoutMs, [this, key](Result<Message> result) { complete(key, result); });
+    }
+    catch (const Exception& exc)
+    {
+        complete(key, exc.status);
+    }
+    catch (...)
+    {
+        // The flight must leave the table, otherwise later identical requests would wait for it forever
+        complete(key, Status::Error);
+    }
+}
+
+void RequestCoalescer::complete(const std::string& key, const Result<Message>& result)
+{
+    std::vector<RequestCb> waiters;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto it = _flights.find(key);
+        if (it == _flights.end())
+            return;
+
+        waiters.swap(it->second);
+        _flights.erase(it);
+    }
+
+    for (auto&& waiter : waiters)
+        waiter(result);
+}
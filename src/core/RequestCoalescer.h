@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Entities.h"
+#include "Message.h"
+#include "Result.h"
+
+namespace NatsMq
+{
+    class ResponseMux;
+
+    //! Single-flight for requests: identical requests (same subject and payload) issued while
+    //! the first one is in flight wait for its reply instead of being sent again.
+    class RequestCoalescer
+    {
+    public:
+        //! Requests with headers are never coalesced. The timeout of the first request applies to all waiters.
+        void request(ResponseMux& mux, Message msg, uint64_t timeoutMs, RequestCb cb);
+
+    private:
+        void complete(const std::string& key, const Result<Message>& result);
+
+    private:
+        std::mutex                                              _mutex;
+        std::unordered_map<std::string, std::vector<RequestCb>> _flights;
+    };
+}
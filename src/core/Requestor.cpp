@@ -1,55 +1,63 @@
 #include "Requestor.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+
 #include "Entities.h"
 #include "Exceptions.h"
 #include "Message.h"
+#include "core/Publisher.h"
+#include "core/ResponseMux.h"
+#include "private/defines.h"
 #include "private/utils.h"
 
 using namespace NatsMq;
 
 namespace
 {
-    using MsgPromise = std::promise<NatsMq::Message>;
-
-    using NatsMsgPtr   = std::unique_ptr<natsMsg, decltype(&natsMsg_Destroy)>;
     using NatsInboxPtr = std::unique_ptr<natsInbox, decltype(&natsInbox_Destroy)>;
-    using NatsSubPtr   = std::unique_ptr<natsSubscription, decltype(&natsSubscription_Destroy)>;
 
     std::string createUniqueInbox()
     {
         natsInbox* inbox{ nullptr };
-        natsInbox_Create(&inbox);
+        exceptionIfError(natsInbox_Create(&inbox));
 
         NatsInboxPtr ptr(inbox, &natsInbox_Destroy);
 
         return ptr.get();
     }
 
-    void asyncRequestCallback(natsConnection* /*nc*/, natsSubscription* natsSub, natsMsg* cnatsMsg, void* closure)
+    int64_t millisecondsLeft(std::chrono::steady_clock::time_point deadline)
     {
-        std::unique_ptr<MsgPromise> promise(reinterpret_cast<MsgPromise*>(closure));
+        return std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    }
 
-        NatsMq::NatsMsgPtr msg(cnatsMsg, &natsMsg_Destroy);
-        NatsSubPtr         sub(natsSub, &natsSubscription_Destroy);
+    int64_t jitteredBackoff(const NatsMq::RequestPolicy& policy, int retry)
+    {
+        thread_local std::minstd_rand generator(std::random_device{}());
 
-        try
-        {
-            if (!msg)
-                throw NatsMq::Exception(NatsMq::Status::Timeout);
-            if (natsMsg_IsNoResponders(cnatsMsg))
-                throw NatsMq::Exception(NatsMq::Status::NoResponders);
+        const auto base = std::min(policy.retryBackoffMs << std::min(retry, 30), policy.maxRetryBackoffMs);
+        if (base <= 0)
+            return 0;
 
-            promise->set_value(fromCnatsMessage(msg.get()));
-        }
-        catch (...)
-        {
-            promise->set_exception(std::current_exception());
-        }
-    };
+        return std::uniform_int_distribution<int64_t>(0, base)(generator);
+    }
+
+    bool isRetriable(NatsMq::Status status)
+    {
+        return status == NatsMq::Status::NoResponders || status == NatsMq::Status::Timeout;
+    }
 }
 
-Requestor::Requestor(natsConnection* connection)
+Requestor::Requestor(natsConnection* connection, ResponseMux* mux)
     : _connection(connection)
+    , _mux(mux)
 {
 }
 
@@ -67,18 +75,162 @@ Message Requestor::request(Message msg, uint64_t timeoutMs) const
     return fromCnatsMessage(replyMsg);
 }
 
-std::future<Message> Requestor::arequest(Message msg, uint64_t timeoutMs) const
+Message Requestor::request(const Message& msg, uint64_t timeoutMs, const RequestPolicy& policy) const
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (int retry = 0;; ++retry)
+    {
+        const auto left        = millisecondsLeft(deadline);
+        const auto attemptTime = policy.attemptTimeoutMs > 0 ? std::min(policy.attemptTimeoutMs, left) : left;
+
+        auto result = attempt(msg, attemptTime, policy);
+        if (result)
+            return std::move(result).value();
+
+        if (!isRetriable(result.status()) || retry >= policy.maxRetries)
+            throw Exception(result.status());
+
+        const auto backoff = std::min(jitteredBackoff(policy, retry), millisecondsLeft(deadline));
+        if (backoff > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoff));
+
+        if (millisecondsLeft(deadline) <= 0)
+            throw Exception(Status::Timeout);
+    }
+}
+
+Result<Message> Requestor::attempt(const Message& msg, int64_t timeoutMs, const RequestPolicy& policy) const
 {
-    auto promise = std::make_unique<MsgPromise>();
+    if (timeoutMs <= 0)
+        return Status::Timeout;
+
+    // Shared with the reply callbacks, they may outlive this call if a hedge copy is answered late
+    struct State
+    {
+        std::mutex                     mutex;
+        std::condition_variable        cv;
+        std::optional<Result<Message>> result;
+        int                            outstanding{ 0 };
+    };
+
+    auto state = std::make_shared<State>();
+
+    auto send = [this, &msg, state](int64_t timeout) {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            ++state->outstanding;
+        }
+
+        auto onReply = [state](Result<Message> reply) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+
+            --state->outstanding;
+
+            if (reply)
+                state->result.emplace(std::move(reply));
+            else if (state->outstanding == 0)
+                state->result.emplace(reply.status());
+            else
+                return;
+
+            state->cv.notify_one();
+        };
+
+        try
+        {
+            _mux->request(msg, std::max<int64_t>(timeout, 1), std::move(onReply));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            --state->outstanding;
+            throw;
+        }
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    send(timeoutMs);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    if (policy.hedgeDelayMs > 0)
+    {
+        for (int hedge = 0; hedge < policy.maxHedges && !state->result; ++hedge)
+        {
+            const auto hedgeAt = std::min(std::chrono::steady_clock::now() + std::chrono::milliseconds(policy.hedgeDelayMs), deadline);
+            if (state->cv.wait_until(lock, hedgeAt, [&state] { return state->result.has_value(); }) || hedgeAt == deadline)
+                break;
+
+            lock.unlock();
+            send(millisecondsLeft(deadline));
+            lock.lock();
+        }
+    }
+
+    // Every copy fails by its own timeout at the latest, so this wait is bounded
+    state->cv.wait(lock, [&state] { return state->result.has_value(); });
+
+    return std::move(*state->result);
+}
+
+std::vector<Message> Requestor::requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs) const
+{
+    std::vector<Message> replies;
+
+    requestMany(std::move(msg), maxReplies, timeoutMs, [&replies](Message reply) {
+        replies.push_back(std::move(reply));
+        return true;
+    });
+
+    return replies;
+}
+
+void Requestor::requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs, const RequestManyCb& cb) const
+{
+    using Clock = std::chrono::steady_clock;
 
     const auto inbox = createUniqueInbox();
 
-    natsSubscription* subscription{ nullptr };
+    natsSubscription* sub{ nullptr };
+    exceptionIfError(natsConnection_SubscribeSync(&sub, _connection, inbox.c_str()));
+
+    NatsSubscriptionPtr subPtr(sub, &natsSubscription_Destroy);
+
+    // The server stops delivery by itself when the limit is reached. A larger limit than cnats accepts
+    // (SIZE_MAX to collect everything until the deadline) is only enforced by the loop below.
+    if (maxReplies > 0 && maxReplies <= static_cast<size_t>(std::numeric_limits<int>::max()))
+        exceptionIfError(natsSubscription_AutoUnsubscribe(sub, static_cast<int>(maxReplies)));
+
+    msg.replySubject = inbox;
 
-    exceptionIfError(natsConnection_SubscribeTimeout(&subscription, _connection, inbox.c_str(), timeoutMs, &asyncRequestCallback, promise.get()));
-    exceptionIfError(natsSubscription_AutoUnsubscribe(subscription, 1));
-    exceptionIfError(natsConnection_PublishRequest(_connection, msg.subject.c_str(), inbox.c_str(), msg.data.data(), static_cast<int>(msg.data.size())));
+    Publisher publisher(_connection);
+    publisher.publish(std::move(msg));
 
-    const auto rawPromise = promise.release();
-    return rawPromise->get_future();
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (size_t received = 0; maxReplies == 0 || received < maxReplies; ++received)
+    {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (left <= 0)
+            break;
+
+        natsMsg*   replyMsg{ nullptr };
+        const auto status = natsSubscription_NextMsg(&replyMsg, sub, left);
+
+        if (status == NATS_TIMEOUT || status == NATS_MAX_DELIVERED_MSGS)
+            break;
+
+        exceptionIfError(status);
+
+        NatsMsgPtr replyPtr(replyMsg, &natsMsg_Destroy);
+
+        // No responders status can be only the first and the only reply
+        if (natsMsg_IsNoResponders(replyMsg))
+            throw Exception(Status::NoResponders);
+
+        if (!cb(fromCnatsMessage(replyMsg)))
+            break;
+    }
 }
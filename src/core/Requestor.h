@@ -2,22 +2,36 @@
 
 #include <nats.h>
 
-#include <future>
+#include <cstdint>
+#include <vector>
+
+#include "Entities.h"
+#include "Result.h"
 
 namespace NatsMq
 {
     class Message;
+    class ResponseMux;
 
     class Requestor
     {
     public:
-        Requestor(natsConnection* connection);
+        Requestor(natsConnection* connection, ResponseMux* mux = nullptr);
 
         Message request(Message msg, uint64_t timeoutMs) const;
 
-        std::future<Message> arequest(Message msg, uint64_t timeoutMs) const;
+        //! Hedged and retried request, requires the response multiplexer
+        Message request(const Message& msg, uint64_t timeoutMs, const RequestPolicy& policy) const;
+
+        std::vector<Message> requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs) const;
+
+        void requestMany(Message msg, size_t maxReplies, uint64_t timeoutMs, const RequestManyCb& cb) const;
+
+    private:
+        Result<Message> attempt(const Message& msg, int64_t timeoutMs, const RequestPolicy& policy) const;
 
     private:
         natsConnection* _connection;
+        ResponseMux*    _mux;
     };
 }
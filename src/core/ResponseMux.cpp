@@ -0,0 +1,228 @@
+#include "ResponseMux.h"
+
+#include <charconv>
+
+#include "Exceptions.h"
+#include "Message.h"
+#include "core/Publisher.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+namespace
+{
+    using NatsInboxPtr = std::unique_ptr<natsInbox, decltype(&natsInbox_Destroy)>;
+
+    //! Multiplexer whose reply callback runs on the current thread
+    thread_local const NatsMq::ResponseMux* currentMux{ nullptr };
+
+    std::string createUniqueInbox()
+    {
+        natsInbox* inbox{ nullptr };
+        exceptionIfError(natsInbox_Create(&inbox));
+
+        NatsInboxPtr ptr(inbox, &natsInbox_Destroy);
+
+        return ptr.get();
+    }
+}
+
+ResponseMux::ResponseMux(natsConnection* connection)
+    : _connection(connection)
+    , _prefix(createUniqueInbox())
+    , _completion(std::make_shared<Completion>())
+    , _sub(nullptr, &natsSubscription_Destroy)
+{
+    const auto subject = _prefix + ".*";
+
+    natsSubscription* sub{ nullptr };
+    exceptionIfError(natsConnection_Subscribe(&sub, connection, subject.c_str(), &ResponseMux::responseCallback, this));
+    _sub.reset(sub);
+
+    // The completion may be signaled after this object is destroyed, so cnats holds its own reference
+    auto completion = std::make_unique<std::shared_ptr<Completion>>(_completion);
+    exceptionIfError(natsSubscription_SetOnCompleteCB(sub, &ResponseMux::completeCallback, completion.get()));
+    completion.release();
+
+    exceptionIfError(natsSubscription_SetPendingLimits(sub, -1, -1));
+    exceptionIfError(natsSubscription_NoDeliveryDelay(sub));
+}
+
+ResponseMux::~ResponseMux()
+{
+    // A closed connection has already closed the subscription, then the status is an error and the completion is already signaled
+    natsSubscription_Unsubscribe(_sub.get());
+
+    // Callbacks in progress reference this object. Counting them in the callback is not enough:
+    // cnats may have taken a message before the unsubscribe and not yet entered the callback.
+    // The completion is signaled after the last callback returned, unless the last reference is dropped inside a callback.
+    if (currentMux != this)
+    {
+        std::unique_lock<std::mutex> lock(_completion->mutex);
+        _completion->cv.wait(lock, [this] { return _completion->done; });
+    }
+
+    std::unordered_map<uint64_t, Pending> pending;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        pending.swap(_pending);
+    }
+
+    for (auto&& [token, request] : pending)
+        request.callback(Status::ConnectionClosed);
+}
+
+void ResponseMux::request(Message msg, uint64_t timeoutMs, RequestCb cb)
+{
+    uint64_t token;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        token = _nextToken++;
+
+        auto& pending    = _pending[token];
+        pending.callback = std::move(cb);
+        // The entry is already in the table, so the timer can't fire before it is registered
+        pending.timerId = _timers.schedule(timeoutMs, [this, token] { expire(token); });
+    }
+
+    msg.replySubject = _prefix + '.' + std::to_string(token);
+
+    try
+    {
+        Publisher publisher(_connection);
+        publisher.publish(std::move(msg));
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // The timer (or a reply) may have completed the request already, then the callback owns the outcome
+            const auto it = _pending.find(token);
+            if (it == _pending.end())
+                return;
+
+            _timers.cancel(it->second.timerId);
+            _pending.erase(it);
+        }
+        throw;
+    }
+}
+
+void ResponseMux::requestBatch(std::vector<Message> msgs, uint64_t timeoutMs, RequestBatchCb cb)
+{
+    if (msgs.empty())
+    {
+        cb({});
+        return;
+    }
+
+    struct Batch
+    {
+        std::vector<Result<Message>> results;
+        std::atomic<size_t>          remaining;
+        RequestBatchCb               callback;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    batch->results.assign(msgs.size(), Result<Message>(Status::Timeout));
+    batch->remaining = msgs.size();
+    batch->callback  = std::move(cb);
+
+    // Each result slot is written by one request only, the last completed request fires the callback
+    auto complete = [batch](size_t idx, Result<Message> result) {
+        batch->results[idx] = std::move(result);
+        if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            batch->callback(std::move(batch->results));
+    };
+
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        try
+        {
+            request(std::move(msgs[i]), timeoutMs, [complete, i](Result<Message> result) { complete(i, std::move(result)); });
+        }
+        catch (const Exception& exc)
+        {
+            complete(i, exc.status);
+        }
+        catch (...)
+        {
+            // The other requests are already in flight, so the batch must still be completed
+            complete(i, Status::Error);
+        }
+    }
+}
+
+void ResponseMux::responseCallback(natsConnection*, natsSubscription*, natsMsg* msg, void* closure)
+{
+    const auto mux = reinterpret_cast<ResponseMux*>(closure);
+    NatsMsgPtr ptr(msg, &natsMsg_Destroy);
+
+    // The callback may drop the last reference to the multiplexer, it must not be touched after responseReady()
+    currentMux = mux;
+    mux->responseReady(msg);
+    currentMux = nullptr;
+}
+
+void ResponseMux::completeCallback(void* closure)
+{
+    const std::unique_ptr<std::shared_ptr<Completion>> completion(reinterpret_cast<std::shared_ptr<Completion>*>(closure));
+
+    {
+        std::lock_guard<std::mutex> lock((*completion)->mutex);
+        (*completion)->done = true;
+    }
+
+    (*completion)->cv.notify_all();
+}
+
+void ResponseMux::responseReady(natsMsg* msg)
+{
+    const std::string_view subject(natsMsg_GetSubject(msg));
+    const auto             tokenStr = subject.substr(_prefix.size() + 1);
+
+    uint64_t token{ 0 };
+    if (std::from_chars(tokenStr.data(), tokenStr.data() + tokenStr.size(), token).ec != std::errc())
+        return;
+
+    RequestCb callback;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto it = _pending.find(token);
+        if (it == _pending.end())
+            return;
+
+        _timers.cancel(it->second.timerId);
+        callback = std::move(it->second.callback);
+        _pending.erase(it);
+    }
+
+    if (natsMsg_IsNoResponders(msg))
+        callback(Status::NoResponders);
+    else
+        callback(fromCnatsMessage(msg));
+}
+
+void ResponseMux::expire(uint64_t token)
+{
+    RequestCb callback;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto it = _pending.find(token);
+        if (it == _pending.end())
+            return;
+
+        callback = std::move(it->second.callback);
+        _pending.erase(it);
+    }
+
+    callback(Status::Timeout);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <nats.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Message.h"
+#include "Result.h"
+#include "core/TimerWheel.h"
+#include "private/defines.h"
+
+namespace NatsMq
+{
+    //! Multiplexes async requests of one connection over a single wildcard inbox subscription.
+    //! Each request gets a token that is appended to the inbox prefix and used as the reply subject.
+    class ResponseMux
+    {
+    public:
+        ResponseMux(natsConnection* connection);
+
+        ~ResponseMux();
+
+        //! Send request, the callback is invoked on the delivery thread with the reply
+        //! or on the timer thread with Status::Timeout. Publish errors are thrown right away,
+        //! unless the request has already been completed by the timer: the callback is invoked exactly once or an exception is thrown.
+        void request(Message msg, uint64_t timeoutMs, RequestCb cb);
+
+        //! Send all requests, the callback is invoked once when all of them are completed.
+        //! Publish errors are reported as results of the corresponding requests.
+        void requestBatch(std::vector<Message> msgs, uint64_t timeoutMs, RequestBatchCb cb);
+
+    private:
+        struct Pending
+        {
+            RequestCb callback;
+            uint64_t  timerId;
+        };
+
+        //! Set by cnats once the subscription is closed and its last callback returned
+        struct Completion
+        {
+            std::mutex              mutex;
+            std::condition_variable cv;
+            bool                    done{ false };
+        };
+
+        static void responseCallback(natsConnection* nc, natsSubscription* sub, natsMsg* msg, void* closure);
+
+        static void completeCallback(void* closure);
+
+        void responseReady(natsMsg* msg);
+
+        void expire(uint64_t token);
+
+    private:
+        natsConnection* _connection;
+        std::string     _prefix;
+
+        std::mutex                            _mutex;
+        std::unordered_map<uint64_t, Pending> _pending;
+        uint64_t                              _nextToken{ 1 };
+
+        TimerWheel                  _timers;
+        std::shared_ptr<Completion> _completion;
+        NatsSubscriptionPtr         _sub;
+    };
+}
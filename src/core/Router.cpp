@@ -0,0 +1,47 @@
+#include "Router.h"
+
+#include "RouterPrivate.h"
+#include "Subject.h"
+
+using namespace NatsMq;
+
+Router::Router(RouterPrivate* impl)
+    : _impl(impl)
+{
+}
+
+Router::~Router() = default;
+
+Router::Router(Router&&) = default;
+
+Router& Router::operator=(Router&&) = default;
+
+uint64_t Router::add(const std::string& pattern, SubscriptionCb cb)
+{
+    return _impl->add(pattern, std::move(cb));
+}
+
+uint64_t Router::add(const Subject& pattern, SubscriptionCb cb)
+{
+    return _impl->add(pattern, std::move(cb));
+}
+
+void Router::remove(uint64_t id)
+{
+    _impl->remove(id);
+}
+
+size_t Router::size() const
+{
+    return _impl->size();
+}
+
+uint64_t Router::unmatched() const noexcept
+{
+    return _impl->unmatched();
+}
+
+SubscriptionStatistic Router::statistics() const
+{
+    return _impl->statistics();
+}
@@ -0,0 +1,87 @@
+#include "RouterPrivate.h"
+
+#include <mutex>
+#include <vector>
+
+#include "Exceptions.h"
+#include "Message.h"
+#include "Subject.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+RouterPrivate::RouterPrivate(natsConnection* connection, const std::string& subject, const std::string& queue, const DeliveryOptions& delivery, ErrorCb onError)
+    : _sub(new SubscriptionPrivate(connection, subject, queue))
+{
+    _sub->registerListener([this](Message msg) { dispatch(std::move(msg)); }, delivery, std::move(onError));
+}
+
+uint64_t RouterPrivate::add(const std::string& pattern, SubscriptionCb cb)
+{
+    return add(Subject::pattern(pattern), std::move(cb));
+}
+
+uint64_t RouterPrivate::add(const Subject& pattern, SubscriptionCb cb)
+{
+    if (!cb)
+        throw Exception(Status::InvalidArg);
+
+    auto handler = std::make_shared<const SubscriptionCb>(std::move(cb));
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+
+    const auto id = ++_nextId;
+    _trie.insert(pattern, id, std::move(handler));
+    _patterns.emplace(id, pattern.str());
+    return id;
+}
+
+void RouterPrivate::remove(uint64_t id)
+{
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+
+    const auto it = _patterns.find(id);
+    if (it == _patterns.end())
+        return;
+
+    _trie.erase(it->second, id);
+    _patterns.erase(it);
+}
+
+size_t RouterPrivate::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _trie.size();
+}
+
+uint64_t RouterPrivate::unmatched() const noexcept
+{
+    return _unmatched;
+}
+
+SubscriptionStatistic RouterPrivate::statistics() const
+{
+    return _sub->statistics();
+}
+
+void RouterPrivate::dispatch(Message msg)
+{
+    std::vector<SubjectTrie::Handler> handlers;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        _trie.match(msg.subject, handlers);
+    }
+
+    if (handlers.empty())
+    {
+        ++_unmatched;
+        return;
+    }
+
+    // Handlers run without the lock, so they can add and remove routes
+    for (size_t i = 0; i + 1 < handlers.size(); ++i)
+        (*handlers[i])(msg);
+
+    (*handlers.back())(std::move(msg));
+}
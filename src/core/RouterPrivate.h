@@ -0,0 +1,50 @@
+#pragma once
+
+#include <nats.h>
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Entities.h"
+#include "core/SubjectTrie.h"
+#include "core/SubscriptionPrivate.h"
+
+namespace NatsMq
+{
+    class Subject;
+
+    class RouterPrivate
+    {
+    public:
+        RouterPrivate(natsConnection* connection, const std::string& subject, const std::string& queue, const DeliveryOptions& delivery, ErrorCb onError);
+
+        uint64_t add(const std::string& pattern, SubscriptionCb cb);
+
+        uint64_t add(const Subject& pattern, SubscriptionCb cb);
+
+        void remove(uint64_t id);
+
+        size_t size() const;
+
+        uint64_t unmatched() const noexcept;
+
+        SubscriptionStatistic statistics() const;
+
+    private:
+        void dispatch(Message msg);
+
+    private:
+        mutable std::shared_mutex                 _mutex;
+        SubjectTrie                               _trie;
+        std::unordered_map<uint64_t, std::string> _patterns;
+        uint64_t                                  _nextId{ 0 };
+
+        std::atomic<uint64_t> _unmatched{ 0 };
+
+        //! Last member, the subscription is closed before the trie is destroyed
+        std::unique_ptr<SubscriptionPrivate> _sub;
+    };
+}
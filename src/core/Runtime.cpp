@@ -0,0 +1,36 @@
+#include "Runtime.h"
+
+#include <mutex>
+
+#include "core/DeliveryQueue.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+namespace
+{
+    std::mutex    configMutex;
+    RuntimeConfig currentConfig;
+}
+
+void Runtime::configure(const RuntimeConfig& config)
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+
+    if (config.deliveryPoolSize > currentConfig.deliveryPoolSize)
+    {
+        configurePoolSize(config.deliveryPoolSize);
+        currentConfig.deliveryPoolSize = config.deliveryPoolSize;
+    }
+}
+
+RuntimeConfig Runtime::config()
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return currentConfig;
+}
+
+std::vector<DeliveryStatistic> Runtime::deliveryStatistics()
+{
+    return DeliveryQueue::allStatistics();
+}
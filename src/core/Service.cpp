@@ -0,0 +1,46 @@
+#include "Service.h"
+
+#include "ServicePrivate.h"
+
+using namespace NatsMq;
+
+Service::Service(ServicePrivate* impl)
+    : _impl(impl)
+{
+}
+
+Service::~Service() = default;
+
+Service::Service(Service&&) = default;
+
+Service& Service::operator=(Service&&) = default;
+
+void Service::addEndpoint(const std::string& name, ServiceHandler handler, const std::string& subject)
+{
+    _impl->addEndpoint(name, std::move(handler), subject);
+}
+
+std::string Service::id() const
+{
+    return _impl->id();
+}
+
+std::string Service::name() const
+{
+    return _impl->name();
+}
+
+std::vector<EndpointStatistic> Service::statistics() const
+{
+    return _impl->statistics();
+}
+
+void Service::resetStatistics()
+{
+    _impl->resetStatistics();
+}
+
+void Service::stop()
+{
+    _impl->stop();
+}
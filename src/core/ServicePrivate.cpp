@@ -0,0 +1,399 @@
+#include "ServicePrivate.h"
+
+#include <cctype>
+#include <ctime>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
+#include "Exceptions.h"
+#include "Subject.h"
+#include "core/Publisher.h"
+#include "private/picojson.h"
+#include "private/utils.h"
+
+using namespace NatsMq;
+
+namespace
+{
+    constexpr auto    srvPrefix{ "$SRV" };
+    constexpr int64_t drainTimeoutMs{ 5000 };
+    constexpr int     tooManyRequestsCode{ 503 };
+    constexpr int     handlerErrorCode{ 500 };
+
+    bool isValidName(const std::string& name)
+    {
+        if (name.empty())
+            return false;
+
+        for (const auto c : name)
+        {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+                return false;
+        }
+
+        return true;
+    }
+
+    std::string utcNow()
+    {
+        const auto now = std::time(nullptr);
+
+        std::tm tm{};
+#ifdef _WIN32
+        gmtime_s(&tm, &now);
+#else
+        gmtime_r(&now, &tm);
+#endif
+
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+        return oss.str();
+    }
+
+    template <typename Sub>
+    void drainQuietly(const Sub& sub) noexcept
+    {
+        try
+        {
+            sub->drain(-1);
+            sub->waitDrain(drainTimeoutMs);
+        }
+        catch (const Exception&)
+        {
+            // the connection is already closed, nothing to wait for
+        }
+    }
+}
+
+ServicePrivate::ServicePrivate(natsConnection* connection, const ServiceConfig& config)
+    : _connection(connection)
+    , _config(config)
+    , _id(Utils::uuid())
+    , _started(utcNow())
+    , _pool(config.workers)
+{
+    if (!isValidName(config.name))
+        throw Exception(Status::InvalidArg);
+
+    subscribeMonitoring();
+}
+
+ServicePrivate::~ServicePrivate()
+{
+    stop();
+}
+
+void ServicePrivate::addEndpoint(const std::string& name, ServiceHandler handler, const std::string& subject)
+{
+    if (_stopped)
+        throw Exception(Status::IllegalState);
+
+    if (!isValidName(name))
+        throw Exception(Status::InvalidArg);
+
+    auto endpoint     = std::make_unique<Endpoint>();
+    endpoint->name    = name;
+    endpoint->subject = subject.empty() ? name : subject;
+    endpoint->handler = std::move(handler);
+
+    if (!Subjects::isValid(endpoint->subject, true))
+        throw Exception(Status::InvalidSubject);
+
+    auto& ref    = *endpoint;
+    endpoint->sub = std::make_unique<SubscriptionPrivate>(_connection, endpoint->subject, _config.queueGroup);
+    endpoint->sub->registerListener([this, &ref](Message msg) { requestReceived(ref, std::move(msg)); });
+
+    std::lock_guard<std::mutex> lock(_endpointsMutex);
+    _endpoints.push_back(std::move(endpoint));
+}
+
+std::string ServicePrivate::id() const
+{
+    return _id;
+}
+
+std::string ServicePrivate::name() const
+{
+    return _config.name;
+}
+
+std::vector<EndpointStatistic> ServicePrivate::statistics() const
+{
+    std::lock_guard<std::mutex> lock(_endpointsMutex);
+
+    std::vector<EndpointStatistic> out;
+    out.reserve(_endpoints.size());
+
+    for (auto&& endpoint : _endpoints)
+    {
+        EndpointStatistic stats;
+        stats.name             = endpoint->name;
+        stats.subject          = endpoint->subject;
+        stats.queueGroup       = _config.queueGroup;
+        stats.requests         = endpoint->requests;
+        stats.errors           = endpoint->errors;
+        stats.processingTimeNs = endpoint->processingTimeNs;
+
+        if (stats.requests > 0)
+            stats.averageProcessingTimeNs = stats.processingTimeNs / static_cast<int64_t>(stats.requests);
+
+        {
+            std::lock_guard<std::mutex> errorLock(endpoint->lastErrorMutex);
+            stats.lastError = endpoint->lastError;
+        }
+
+        out.push_back(std::move(stats));
+    }
+
+    return out;
+}
+
+void ServicePrivate::resetStatistics()
+{
+    std::lock_guard<std::mutex> lock(_endpointsMutex);
+
+    for (auto&& endpoint : _endpoints)
+    {
+        endpoint->requests         = 0;
+        endpoint->errors           = 0;
+        endpoint->processingTimeNs = 0;
+
+        std::lock_guard<std::mutex> errorLock(endpoint->lastErrorMutex);
+        endpoint->lastError.clear();
+    }
+}
+
+void ServicePrivate::stop() noexcept
+{
+    if (_stopped.exchange(true))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_endpointsMutex);
+        for (auto&& endpoint : _endpoints)
+            drainQuietly(endpoint->sub);
+    }
+
+    // All accepted requests are handled before the threads exit
+    _pool.stop();
+
+    for (auto&& sub : _monitoring)
+        drainQuietly(sub);
+}
+
+void ServicePrivate::requestReceived(Endpoint& endpoint, Message msg)
+{
+    if (_inFlight.fetch_add(1) >= _config.maxInFlight)
+    {
+        --_inFlight;
+        replyError(endpoint, msg, tooManyRequestsCode, "too many requests");
+        return;
+    }
+
+    // msg is moved into the task, std::function requires a copyable callable
+    auto       shared = std::make_shared<Message>(std::move(msg));
+    const auto posted = _pool.post([this, &endpoint, shared] {
+        handle(endpoint, std::move(*shared));
+        --_inFlight;
+    });
+
+    // The pool drops tasks once the service is stopping, the request is not counted then
+    if (!posted)
+    {
+        --_inFlight;
+        replyError(endpoint, *shared, tooManyRequestsCode, "service is stopping");
+    }
+}
+
+void ServicePrivate::handle(Endpoint& endpoint, Message msg)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::optional<Message> reply;
+    std::string            error;
+    int                    errorCode{ 0 };
+
+    try
+    {
+        reply = endpoint.handler(msg);
+    }
+    catch (const ServiceError& exc)
+    {
+        errorCode = exc.code;
+        error     = exc.what();
+    }
+    catch (const std::exception& exc)
+    {
+        errorCode = handlerErrorCode;
+        error     = exc.what();
+    }
+    catch (...)
+    {
+        errorCode = handlerErrorCode;
+        error     = "unknown error";
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    ++endpoint.requests;
+    endpoint.processingTimeNs += elapsed;
+
+    if (!reply)
+        return replyError(endpoint, msg, errorCode, error);
+
+    if (msg.replySubject.empty())
+        return;
+
+    reply->subject = msg.replySubject;
+    reply->replySubject.clear();
+
+    try
+    {
+        Publisher publisher(_connection);
+        publisher.publish(std::move(*reply));
+    }
+    catch (const Exception& exc)
+    {
+        ++endpoint.errors;
+        std::lock_guard<std::mutex> lock(endpoint.lastErrorMutex);
+        endpoint.lastError = exc.what();
+    }
+    catch (...)
+    {
+        ++endpoint.errors;
+        std::lock_guard<std::mutex> lock(endpoint.lastErrorMutex);
+        endpoint.lastError = "unknown error";
+    }
+}
+
+void ServicePrivate::replyError(Endpoint& endpoint, const Message& msg, int code, const std::string& description)
+{
+    ++endpoint.errors;
+
+    {
+        std::lock_guard<std::mutex> lock(endpoint.lastErrorMutex);
+        endpoint.lastError = description;
+    }
+
+    if (msg.replySubject.empty())
+        return;
+
+    Message reply;
+    reply.subject = msg.replySubject;
+    reply.headers.set("Nats-Service-Error", description);
+    reply.headers.set("Nats-Service-Error-Code", std::to_string(code));
+
+    try
+    {
+        Publisher publisher(_connection);
+        publisher.publish(std::move(reply));
+    }
+    catch (const Exception&)
+    {
+        // the requester will get a timeout
+    }
+}
+
+void ServicePrivate::subscribeMonitoring()
+{
+    for (const std::string verb : { "PING", "INFO", "STATS" })
+    {
+        const auto base = std::string(srvPrefix) + '.' + verb;
+
+        for (const auto& subject : { base, base + '.' + _config.name, base + '.' + _config.name + '.' + _id })
+        {
+            auto sub = std::make_unique<SubscriptionPrivate>(_connection, subject);
+            sub->registerListener([this, verb](Message msg) { monitoringRequest(verb, msg); });
+            _monitoring.push_back(std::move(sub));
+        }
+    }
+}
+
+void ServicePrivate::monitoringRequest(const std::string& verb, const Message& msg)
+{
+    if (msg.replySubject.empty())
+        return;
+
+    std::string response;
+    if (verb == "PING")
+        response = pingResponse();
+    else if (verb == "INFO")
+        response = infoResponse();
+    else
+        response = statsResponse();
+
+    try
+    {
+        Publisher publisher(_connection);
+        publisher.publish(Message(msg.replySubject, std::move(response)));
+    }
+    catch (const Exception&)
+    {
+        // the requester will get a timeout
+    }
+}
+
+std::string ServicePrivate::pingResponse() const
+{
+    picojson::value::object obj;
+    obj["type"]     = picojson::value("io.nats.micro.v1.ping_response");
+    obj["name"]     = picojson::value(_config.name);
+    obj["id"]       = picojson::value(_id);
+    obj["version"]  = picojson::value(_config.version);
+    obj["metadata"] = picojson::value(picojson::value::object());
+
+    return picojson::value(obj).serialize();
+}
+
+std::string ServicePrivate::infoResponse() const
+{
+    picojson::value::array endpoints;
+    for (auto&& stats : statistics())
+    {
+        picojson::value::object endpoint;
+        endpoint["name"]        = picojson::value(stats.name);
+        endpoint["subject"]     = picojson::value(stats.subject);
+        endpoint["queue_group"] = picojson::value(stats.queueGroup);
+        endpoints.emplace_back(endpoint);
+    }
+
+    picojson::value::object obj;
+    obj["type"]        = picojson::value("io.nats.micro.v1.info_response");
+    obj["name"]        = picojson::value(_config.name);
+    obj["id"]          = picojson::value(_id);
+    obj["version"]     = picojson::value(_config.version);
+    obj["description"] = picojson::value(_config.description);
+    obj["metadata"]    = picojson::value(picojson::value::object());
+    obj["endpoints"]   = picojson::value(endpoints);
+
+    return picojson::value(obj).serialize();
+}
+
+std::string ServicePrivate::statsResponse() const
+{
+    picojson::value::array endpoints;
+    for (auto&& stats : statistics())
+    {
+        picojson::value::object endpoint;
+        endpoint["name"]                    = picojson::value(stats.name);
+        endpoint["subject"]                 = picojson::value(stats.subject);
+        endpoint["queue_group"]             = picojson::value(stats.queueGroup);
+        endpoint["num_requests"]            = picojson::value(static_cast<int64_t>(stats.requests));
+        endpoint["num_errors"]              = picojson::value(static_cast<int64_t>(stats.errors));
+        endpoint["last_error"]              = picojson::value(stats.lastError);
+        endpoint["processing_time"]         = picojson::value(stats.processingTimeNs);
+        endpoint["average_processing_time"] = picojson::value(stats.averageProcessingTimeNs);
+        endpoints.emplace_back(endpoint);
+    }
+
+    picojson::value::object obj;
+    obj["type"]      = picojson::value("io.nats.micro.v1.stats_response");
+    obj["name"]      = picojson::value(_config.name);
+    obj["id"]        = picojson::value(_id);
+    obj["version"]   = picojson::value(_config.version);
+    obj["started"]   = picojson::value(_started);
+    obj["endpoints"] = picojson::value(endpoints);
+
+    return picojson::value(obj).serialize();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <nats.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Entities.h"
+#include "Message.h"
+#include "core/SubscriptionPrivate.h"
+#include "core/WorkerPool.h"
+
+namespace NatsMq
+{
+    class ServicePrivate
+    {
+    public:
+        ServicePrivate(natsConnection* connection, const ServiceConfig& config);
+
+        ~ServicePrivate();
+
+        void addEndpoint(const std::string& name, ServiceHandler handler, const std::string& subject);
+
+        std::string id() const;
+
+        std::string name() const;
+
+        std::vector<EndpointStatistic> statistics() const;
+
+        void resetStatistics();
+
+        void stop() noexcept;
+
+    private:
+        struct Endpoint
+        {
+            std::string    name;
+            std::string    subject;
+            ServiceHandler handler;
+
+            std::atomic<uint64_t> requests{ 0 };
+            std::atomic<uint64_t> errors{ 0 };
+            std::atomic<int64_t>  processingTimeNs{ 0 };
+
+            mutable std::mutex lastErrorMutex;
+            std::string        lastError;
+
+            std::unique_ptr<SubscriptionPrivate> sub;
+        };
+
+        void requestReceived(Endpoint& endpoint, Message msg);
+
+        void handle(Endpoint& endpoint, Message msg);
+
+        void replyError(Endpoint& endpoint, const Message& msg, int code, const std::string& description);
+
+        void subscribeMonitoring();
+
+        void monitoringRequest(const std::string& verb, const Message& msg);
+
+        std::string pingResponse() const;
+
+        std::string infoResponse() const;
+
+        std::string statsResponse() const;
+
+    private:
+        natsConnection* _connection;
+        ServiceConfig   _config;
+        std::string     _id;
+        std::string     _started;
+
+        std::atomic<int>  _inFlight{ 0 };
+        std::atomic<bool> _stopped{ false };
+
+        mutable std::mutex                     _endpointsMutex;
+        std::vector<std::unique_ptr<Endpoint>> _endpoints;
+
+        std::vector<std::unique_ptr<SubscriptionPrivate>> _monitoring;
+
+        WorkerPool _pool;
+    };
+}
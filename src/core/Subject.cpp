@@ -0,0 +1,44 @@
+#include "Subject.h"
+
+#include "Exceptions.h"
+
+using namespace NatsMq;
+
+Subject::Subject(std::string subject)
+    : Subject(std::move(subject), false)
+{
+}
+
+Subject::Subject(std::string subject, bool allowWildcards)
+    : _subject(std::move(subject))
+{
+    if (!Subjects::isValid(_subject, allowWildcards))
+        exceptionIfError(Status::InvalidSubject);
+
+    _pattern = allowWildcards && Subjects::hasWildcards(_subject);
+}
+
+Subject Subject::pattern(std::string subject)
+{
+    return Subject(std::move(subject), true);
+}
+
+const std::string& Subject::str() const noexcept
+{
+    return _subject;
+}
+
+Subject::operator std::string_view() const noexcept
+{
+    return _subject;
+}
+
+bool Subject::isPattern() const noexcept
+{
+    return _pattern;
+}
+
+bool Subject::matches(std::string_view subject) const noexcept
+{
+    return _pattern ? Subjects::matches(_subject, subject) : _subject == subject;
+}
@@ -0,0 +1,151 @@
+#include "SubjectTrie.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace NatsMq;
+
+namespace
+{
+    //! Split off the first token, the rest is empty for the last token
+    std::pair<std::string_view, std::string_view> nextToken(std::string_view subject)
+    {
+        const auto dot = subject.find('.');
+        if (dot == std::string_view::npos)
+            return { subject, {} };
+
+        return { subject.substr(0, dot), subject.substr(dot + 1) };
+    }
+
+    bool removeById(std::vector<std::pair<uint64_t, SubjectTrie::Handler>>& entries, uint64_t id)
+    {
+        const auto it = std::find_if(entries.begin(), entries.end(), [id](auto&& entry) { return entry.first == id; });
+        if (it == entries.end())
+            return false;
+
+        entries.erase(it);
+        return true;
+    }
+}
+
+SubjectTrie::SubjectTrie()
+    : _root(std::make_unique<Node>())
+{
+}
+
+SubjectTrie::~SubjectTrie() = default;
+
+void SubjectTrie::insert(std::string_view pattern, uint64_t id, Handler handler)
+{
+    auto node = _root.get();
+
+    for (auto rest = pattern;;)
+    {
+        const auto [token, next] = nextToken(rest);
+
+        if (token == ">")
+        {
+            node->tail.emplace_back(id, std::move(handler));
+            break;
+        }
+
+        auto& child = token == "*" ? node->any : node->children[std::string(token)];
+        if (!child)
+            child = std::make_unique<Node>();
+
+        node = child.get();
+
+        if (next.empty())
+        {
+            node->handlers.emplace_back(id, std::move(handler));
+            break;
+        }
+
+        rest = next;
+    }
+
+    ++_size;
+}
+
+bool SubjectTrie::erase(std::string_view pattern, uint64_t id)
+{
+    if (!erase(*_root, pattern, id))
+        return false;
+
+    --_size;
+    return true;
+}
+
+void SubjectTrie::match(std::string_view subject, std::vector<Handler>& out) const
+{
+    // One key buffer for the whole walk, the map lookup needs std::string
+    std::string key;
+    match(*_root, subject, key, out);
+}
+
+size_t SubjectTrie::size() const noexcept
+{
+    return _size;
+}
+
+bool SubjectTrie::Node::empty() const noexcept
+{
+    return children.empty() && !any && handlers.empty() && tail.empty();
+}
+
+void SubjectTrie::match(const Node& node, std::string_view subject, std::string& key, std::vector<Handler>& out)
+{
+    // ">" matches one or more tokens, so there is always at least one token left here
+    for (auto&& entry : node.tail)
+        out.push_back(entry.second);
+
+    const auto [token, next] = nextToken(subject);
+    const auto last          = next.empty();
+
+    key.assign(token);
+    if (const auto it = node.children.find(key); it != node.children.end())
+    {
+        if (last)
+            std::transform(it->second->handlers.begin(), it->second->handlers.end(), std::back_inserter(out), [](auto&& entry) { return entry.second; });
+        else
+            match(*it->second, next, key, out);
+    }
+
+    if (node.any)
+    {
+        if (last)
+            std::transform(node.any->handlers.begin(), node.any->handlers.end(), std::back_inserter(out), [](auto&& entry) { return entry.second; });
+        else
+            match(*node.any, next, key, out);
+    }
+}
+
+bool SubjectTrie::erase(Node& node, std::string_view pattern, uint64_t id)
+{
+    const auto [token, next] = nextToken(pattern);
+
+    if (token == ">")
+        return removeById(node.tail, id);
+
+    std::unique_ptr<Node>* child{ nullptr };
+    if (token == "*")
+        child = &node.any;
+    else if (const auto it = node.children.find(std::string(token)); it != node.children.end())
+        child = &it->second;
+
+    if (!child || !*child)
+        return false;
+
+    const auto removed = next.empty() ? removeById((*child)->handlers, id) : erase(**child, next, id);
+
+    // Prune branches left without patterns, so removed devices do not keep memory
+    if (removed && (*child)->empty())
+    {
+        if (token == "*")
+            node.any.reset();
+        else
+            node.children.erase(std::string(token));
+    }
+
+    return removed;
+}
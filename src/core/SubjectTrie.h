@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Entities.h"
+
+namespace NatsMq
+{
+    //! Subject patterns indexed by tokens. Matching a subject visits only the branches of its tokens and of wildcards,
+    //! so the cost does not depend on the number of stored patterns. Not thread safe.
+    class SubjectTrie
+    {
+    public:
+        using Handler = std::shared_ptr<const SubscriptionCb>;
+
+        SubjectTrie();
+
+        ~SubjectTrie();
+
+        //! The pattern must be a valid subject, wildcards are allowed
+        void insert(std::string_view pattern, uint64_t id, Handler handler);
+
+        //! Returns false if there is no such handler
+        bool erase(std::string_view pattern, uint64_t id);
+
+        //! Append handlers of all patterns matching the subject
+        void match(std::string_view subject, std::vector<Handler>& out) const;
+
+        size_t size() const noexcept;
+
+    private:
+        struct Node
+        {
+            std::unordered_map<std::string, std::unique_ptr<Node>> children;
+            std::unique_ptr<Node>                                  any;      ///< "*" token
+            std::vector<std::pair<uint64_t, Handler>>              handlers; ///< Patterns ending at the node
+            std::vector<std::pair<uint64_t, Handler>>              tail;     ///< Patterns ending with ">" after the node
+
+            bool empty() const noexcept;
+        };
+
+        static void match(const Node& node, std::string_view subject, std::string& key, std::vector<Handler>& out);
+
+        static bool erase(Node& node, std::string_view pattern, uint64_t id);
+
+    private:
+        std::unique_ptr<Node> _root;
+        size_t                _size{ 0 };
+    };
+}
@@ -9,9 +9,21 @@ namespace NatsMq
     class SubscriptionBaseTemplate : public SubscriptionBasePrivate<NatsSubscriptionPtr, decltype(natsSubscription_Destroy)>
     {
     public:
+        SubscriptionBaseTemplate()
+            : SubscriptionBasePrivate(nullptr, &natsSubscription_Destroy)
+        {
+        }
+
         template <typename Creator, typename... Args>
         SubscriptionBaseTemplate(Creator creator, Args... args)
-            : SubscriptionBasePrivate(nullptr, &natsSubscription_Destroy)
+            : SubscriptionBaseTemplate()
+        {
+            create(creator, args...);
+        }
+
+    protected:
+        template <typename Creator, typename... Args>
+        void create(Creator creator, Args... args)
         {
             natsSubscription* natsSub{ nullptr };
             exceptionIfError(creator(&natsSub, args...));
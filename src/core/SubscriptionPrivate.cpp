@@ -2,33 +2,59 @@
 
 #include "Exceptions.h"
 #include "Message.h"
+#include "MessageView.h"
+#include "core/MessageViewPrivate.h"
 #include "private/utils.h"
 
 using namespace NatsMq;
 
-SubscriptionPrivate::SubscriptionPrivate(natsConnection* connection, const std::string& subject)
-    : SubscriptionBaseTemplate(&natsConnection_Subscribe, connection, subject.c_str(), &subscriptionCallback, this)
+SubscriptionPrivate::SubscriptionPrivate(natsConnection* connection, std::string subject, std::string queue, int64_t timeoutMs)
+    : _connection(connection)
+    , _subject(std::move(subject))
+    , _queue(std::move(queue))
+    , _timeoutMs(timeoutMs)
 {
 }
 
-SubscriptionPrivate::SubscriptionPrivate(natsConnection* connection, const std::string& subject, int64_t timeoutMs)
-    : SubscriptionBaseTemplate(&natsConnection_SubscribeTimeout, connection, subject.c_str(), timeoutMs, &subscriptionCallback, this)
+void SubscriptionPrivate::registerListener(SubscriptionCb cb, const DeliveryOptions& delivery, ErrorCb onError)
 {
+    _cb = std::move(cb);
+
+    // The queue must exist before the first message is delivered
+    if (delivery.mode != DeliveryMode::Connection)
+    {
+        if (!_cb)
+            throw Exception(Status::InvalidArg);
+
+        // Queued messages may be delivered after the subscription is destroyed, so the callback is shared
+        _deliveryCb = std::make_shared<SubscriptionCb>(_cb);
+        _key        = delivery.key;
+        _delivery   = std::make_unique<DeliveryQueue>(delivery, 0, _subject, std::move(onError));
+    }
+
+    subscribe();
+
+    if (_delivery)
+        _delivery->setSubscriptionId(natsSubscription_GetID(_sub.get()));
 }
 
-SubscriptionPrivate::SubscriptionPrivate(natsConnection* connection, const std::string& subject, const std::string& queue)
-    : SubscriptionPrivate(connection, subject.c_str(), queue.c_str(), 0)
+void SubscriptionPrivate::registerListener(SubscriptionViewCb cb)
 {
+    _viewCb = std::move(cb);
+    subscribe();
 }
 
-SubscriptionPrivate::SubscriptionPrivate(natsConnection* connection, const std::string& subject, const std::string& queue, int64_t timeoutMs)
-    : SubscriptionBaseTemplate(&natsConnection_QueueSubscribeTimeout, connection, subject.c_str(), queue.c_str(), timeoutMs, &subscriptionCallback, this)
+void SubscriptionPrivate::registerListener(SubscriptionBatchCb cb, size_t maxBatch, uint64_t maxLatencyMs, ErrorCb onError)
 {
+    _batcher = std::make_unique<MessageBatcher>(maxBatch, maxLatencyMs, std::move(cb), std::move(onError));
+    subscribe();
 }
 
-void SubscriptionPrivate::registerListener(SubscriptionCb cb)
+SubscriptionPrivate::~SubscriptionPrivate()
 {
-    _cb = std::move(cb);
+    // Stop feeding the delivery queue or the batcher before it is destroyed
+    if (_delivery || _batcher)
+        natsSubscription_Unsubscribe(_sub.get());
 }
 
 void SubscriptionPrivate::drain(int64_t timeout) const
@@ -50,14 +76,41 @@ Status SubscriptionPrivate::drainStatus() const
     return static_cast<Status>(natsSubscription_DrainCompletionStatus(_sub.get()));
 }
 
+void SubscriptionPrivate::subscribe()
+{
+    if (!_queue.empty())
+        create(&natsConnection_QueueSubscribeTimeout, _connection, _subject.c_str(), _queue.c_str(), _timeoutMs, &subscriptionCallback, this);
+    else if (_timeoutMs > 0)
+        create(&natsConnection_SubscribeTimeout, _connection, _subject.c_str(), _timeoutMs, &subscriptionCallback, this);
+    else
+        create(&natsConnection_Subscribe, _connection, _subject.c_str(), &subscriptionCallback, this);
+}
+
 void SubscriptionPrivate::subscriptionCallback(natsConnection*, natsSubscription*, natsMsg* msg, void* closure)
 {
     const auto sub = reinterpret_cast<SubscriptionPrivate*>(closure);
     NatsMsgPtr ptr(msg, &natsMsg_Destroy);
-    sub->dataReady(fromCnatsMessage(msg));
+
+    if (sub->_viewCb)
+        sub->dataReady(msg);
+    else
+        sub->dataReady(fromCnatsMessage(msg));
 }
 
 void SubscriptionPrivate::dataReady(Message msg)
 {
-    _cb(std::move(msg));
+    if (_batcher)
+        return _batcher->push(std::move(msg));
+
+    if (!_delivery)
+        return _cb(std::move(msg));
+
+    const auto lane = _key ? _delivery->lane(_key(msg)) : 0;
+    _delivery->post(lane, [cb = _deliveryCb, msg = std::move(msg)]() mutable { (*cb)(std::move(msg)); });
+}
+
+void SubscriptionPrivate::dataReady(natsMsg* msg)
+{
+    const MessageViewPrivate view(msg);
+    _viewCb(MessageView(&view));
 }
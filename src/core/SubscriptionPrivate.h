@@ -3,8 +3,11 @@
 #include <nats.h>
 
 #include <memory>
+#include <string>
 
 #include "Entities.h"
+#include "core/DeliveryQueue.h"
+#include "core/MessageBatcher.h"
 #include "core/SubscriptionBaseTemplate.h"
 
 namespace NatsMq
@@ -12,15 +15,19 @@ namespace NatsMq
     class SubscriptionPrivate final : public SubscriptionBaseTemplate
     {
     public:
-        SubscriptionPrivate(natsConnection* connection, const std::string& subject);
+        //! The subscription is created by registerListener(), once everything the callback uses is in place,
+        //! so no message can be delivered to a half-initialized object. A zero timeout means no timeout.
+        SubscriptionPrivate(natsConnection* connection, std::string subject, std::string queue = {}, int64_t timeoutMs = 0);
 
-        SubscriptionPrivate(natsConnection* connection, const std::string& subject, int64_t timeoutMs);
+        ~SubscriptionPrivate() override;
 
-        SubscriptionPrivate(natsConnection* connection, const std::string& subject, const std::string& queue);
+        //! Callbacks are invoked on the connection thread, or by a delivery queue built before the subscription is created.
+        //! Exceptions thrown by queued callbacks are passed to onError.
+        void registerListener(SubscriptionCb cb, const DeliveryOptions& delivery = {}, ErrorCb onError = {});
 
-        SubscriptionPrivate(natsConnection* connection, const std::string& subject, const std::string& queue, int64_t timeoutMs);
+        void registerListener(SubscriptionViewCb cb);
 
-        void registerListener(SubscriptionCb cb);
+        void registerListener(SubscriptionBatchCb cb, size_t maxBatch, uint64_t maxLatencyMs, ErrorCb onError = {});
 
         void drain(int64_t timeout) const;
 
@@ -29,11 +36,27 @@ namespace NatsMq
         Status drainStatus() const;
 
     private:
+        void subscribe();
+
         static void subscriptionCallback(natsConnection* nc, natsSubscription* sub, natsMsg* msg, void* closure);
 
         void dataReady(Message msg);
 
+        void dataReady(natsMsg* msg);
+
     private:
-        SubscriptionCb _cb;
+        natsConnection* _connection;
+        std::string     _subject;
+        std::string     _queue;
+        int64_t         _timeoutMs;
+
+        SubscriptionCb     _cb;
+        SubscriptionViewCb _viewCb;
+
+        std::shared_ptr<SubscriptionCb> _deliveryCb;
+        std::unique_ptr<DeliveryQueue>  _delivery;
+        KeyExtractor                    _key;
+
+        std::unique_ptr<MessageBatcher> _batcher;
     };
 }
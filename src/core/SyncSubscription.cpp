@@ -26,6 +26,11 @@ Message SyncSubscription::next(int64_t timeoutMs) const
     return _impl->next(timeoutMs);
 }
 
+size_t SyncSubscription::nextBatch(size_t maxCount, int64_t timeoutMs, std::vector<Message>& out) const
+{
+    return _impl->nextBatch(maxCount, timeoutMs, out);
+}
+
 SubscriptionStatistic SyncSubscription::statistics() const
 {
     return _impl->statistics();
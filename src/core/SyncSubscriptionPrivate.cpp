@@ -18,6 +18,8 @@ SyncSubscriptionPrivate::SyncSubscriptionPrivate(natsConnection* connection, con
 
 Message SyncSubscriptionPrivate::next(int64_t timeoutMs) const
 {
+    throwDeferredError();
+
     natsMsg* msg{ nullptr };
     exceptionIfError(natsSubscription_NextMsg(&msg, _sub.get(), timeoutMs));
 
@@ -25,3 +27,38 @@ Message SyncSubscriptionPrivate::next(int64_t timeoutMs) const
 
     return fromCnatsMessage(msg);
 }
+
+size_t SyncSubscriptionPrivate::nextBatch(size_t maxCount, int64_t timeoutMs, std::vector<Message>& out) const
+{
+    out.clear();
+
+    throwDeferredError();
+
+    for (int64_t timeout = timeoutMs; out.size() < maxCount; timeout = 0)
+    {
+        // Zero timeout does not wait, cnats reports timeout as soon as the queue is empty
+        natsMsg*   msg{ nullptr };
+        const auto status = natsSubscription_NextMsg(&msg, _sub.get(), timeout);
+        if (status == NATS_TIMEOUT)
+            break;
+
+        // Errors like slow consumer are reported by cnats only once, the messages already taken must not be lost
+        if (status != NATS_OK && !out.empty())
+        {
+            _deferredError = static_cast<Status>(status);
+            break;
+        }
+
+        exceptionIfError(status);
+
+        NatsMsgPtr ptr(msg, &natsMsg_Destroy);
+        out.push_back(fromCnatsMessage(msg));
+    }
+
+    return out.size();
+}
+
+void SyncSubscriptionPrivate::throwDeferredError() const
+{
+    exceptionIfError(_deferredError.exchange(Status::Ok));
+}
@@ -2,7 +2,9 @@
 
 #include <nats.h>
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "Entities.h"
 #include "core/SubscriptionBaseTemplate.h"
@@ -17,5 +19,14 @@ namespace NatsMq
         SyncSubscriptionPrivate(natsConnection* connection, const std::string& subject, const std::string& queue);
 
         Message next(int64_t timeoutMs) const;
+
+        size_t nextBatch(size_t maxCount, int64_t timeoutMs, std::vector<Message>& out) const;
+
+    private:
+        void throwDeferredError() const;
+
+    private:
+        //! Error met by nextBatch() after some messages were taken, thrown by the next call
+        mutable std::atomic<Status> _deferredError{ Status::Ok };
     };
 }
@@ -0,0 +1,32 @@
+#include "ThreadPoolExecutor.h"
+
+#include "ThreadPoolExecutorPrivate.h"
+
+using namespace NatsMq;
+
+ThreadPoolExecutor::ThreadPoolExecutor(int threads)
+    : _impl(std::make_unique<ThreadPoolExecutorPrivate>(threads))
+{
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() = default;
+
+void ThreadPoolExecutor::execute(Task task)
+{
+    _impl->execute(std::move(task));
+}
+
+int ThreadPoolExecutor::threadCount() const noexcept
+{
+    return _impl->threadCount();
+}
+
+size_t ThreadPoolExecutor::queuedTasks() const noexcept
+{
+    return _impl->queuedTasks();
+}
+
+size_t ThreadPoolExecutor::failedTasks() const noexcept
+{
+    return _impl->failedTasks();
+}
@@ -0,0 +1,140 @@
+#include "ThreadPoolExecutorPrivate.h"
+
+#include <algorithm>
+
+using namespace NatsMq;
+
+namespace
+{
+    //! Pool and queue index of the current worker thread, tasks posted from a worker go to its own queue
+    thread_local const ThreadPoolExecutorPrivate* currentPool{ nullptr };
+    thread_local size_t                           currentQueue{ 0 };
+}
+
+ThreadPoolExecutorPrivate::ThreadPoolExecutorPrivate(int threads)
+{
+    if (threads <= 0)
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    _queues.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        _queues.push_back(std::make_unique<Queue>());
+
+    _threads.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        _threads.emplace_back(&ThreadPoolExecutorPrivate::run, this, static_cast<size_t>(i));
+}
+
+ThreadPoolExecutorPrivate::~ThreadPoolExecutorPrivate()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopped = true;
+    }
+
+    _cv.notify_all();
+
+    for (auto&& thread : _threads)
+        thread.join();
+}
+
+void ThreadPoolExecutorPrivate::execute(Executor::Task task)
+{
+    const auto idx = currentPool == this ? currentQueue : _next.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+
+    {
+        // Counted before the push, so a worker taking the task right away can't bring the counter below zero.
+        // Under the sleep mutex, so a worker can't miss the wake up between its check and wait.
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_pending;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queues[idx]->mutex);
+        _queues[idx]->tasks.push_back(std::move(task));
+    }
+
+    _cv.notify_one();
+}
+
+int ThreadPoolExecutorPrivate::threadCount() const noexcept
+{
+    return static_cast<int>(_threads.size());
+}
+
+size_t ThreadPoolExecutorPrivate::queuedTasks() const noexcept
+{
+    return _pending;
+}
+
+size_t ThreadPoolExecutorPrivate::failedTasks() const noexcept
+{
+    return _failed;
+}
+
+void ThreadPoolExecutorPrivate::run(size_t idx)
+{
+    currentPool  = this;
+    currentQueue = idx;
+
+    for (;;)
+    {
+        Executor::Task task;
+
+        if (pop(idx, task) || steal(idx, task))
+        {
+            --_pending;
+
+            // A throwing task must not take the worker thread down
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                ++_failed;
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _cv.wait(lock, [this] { return _stopped || _pending > 0; });
+
+        // Queued tasks are executed before exit
+        if (_stopped && _pending == 0)
+            return;
+    }
+}
+
+bool ThreadPoolExecutorPrivate::pop(size_t idx, Executor::Task& task)
+{
+    auto& queue = *_queues[idx];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPoolExecutorPrivate::steal(size_t idx, Executor::Task& task)
+{
+    for (size_t i = 1; i < _queues.size(); ++i)
+    {
+        auto& queue = *_queues[(idx + i) % _queues.size()];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        // Take the newest task, the owner keeps working from the oldest one
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    return false;
+}
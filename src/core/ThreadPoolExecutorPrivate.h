@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Executor.h"
+
+namespace NatsMq
+{
+    class ThreadPoolExecutorPrivate
+    {
+    public:
+        ThreadPoolExecutorPrivate(int threads);
+
+        ~ThreadPoolExecutorPrivate();
+
+        void execute(Executor::Task task);
+
+        int threadCount() const noexcept;
+
+        size_t queuedTasks() const noexcept;
+
+        size_t failedTasks() const noexcept;
+
+    private:
+        struct Queue
+        {
+            std::mutex                 mutex;
+            std::deque<Executor::Task> tasks;
+        };
+
+        void run(size_t idx);
+
+        bool pop(size_t idx, Executor::Task& task);
+
+        bool steal(size_t idx, Executor::Task& task);
+
+    private:
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::atomic<size_t>                 _next{ 0 };
+
+        std::mutex              _sleepMutex;
+        std::condition_variable _cv;
+        std::atomic<size_t>     _pending{ 0 };
+        std::atomic<size_t>     _failed{ 0 };
+        bool                    _stopped{ false };
+
+        std::vector<std::thread> _threads;
+    };
+}
@@ -0,0 +1,89 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+using namespace NatsMq;
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slots)
+    : _tick(tick)
+    , _slots(slots)
+{
+    _thread = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+
+    _cv.notify_all();
+    _thread.join();
+}
+
+uint64_t TimerWheel::schedule(uint64_t delayMs, Callback cb)
+{
+    const auto tickMs = static_cast<uint64_t>(_tick.count());
+    const auto ticks  = std::max<uint64_t>(1, (delayMs + tickMs - 1) / tickMs);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto id   = _nextId++;
+    const auto slot = (_current + ticks) % _slots.size();
+
+    _timers.emplace(id, Timer{ (ticks - 1) / _slots.size(), std::move(cb) });
+    _slots[slot].push_back(id);
+
+    return id;
+}
+
+bool TimerWheel::cancel(uint64_t id)
+{
+    // The id stays in its slot and is skipped when the slot is processed
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _timers.erase(id) > 0;
+}
+
+void TimerWheel::run()
+{
+    auto nextTick = std::chrono::steady_clock::now() + _tick;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_stopped)
+    {
+        if (_cv.wait_until(lock, nextTick, [this] { return _stopped; }))
+            break;
+
+        nextTick += _tick;
+        _current = (_current + 1) % _slots.size();
+
+        std::vector<Callback> expired;
+        std::vector<uint64_t> postponed;
+
+        for (auto id : _slots[_current])
+        {
+            const auto it = _timers.find(id);
+            if (it == _timers.end())
+                continue;
+
+            if (it->second.rounds)
+            {
+                --it->second.rounds;
+                postponed.push_back(id);
+                continue;
+            }
+
+            expired.push_back(std::move(it->second.callback));
+            _timers.erase(it);
+        }
+
+        _slots[_current] = std::move(postponed);
+
+        lock.unlock();
+        for (auto&& cb : expired)
+            cb();
+        lock.lock();
+    }
+}
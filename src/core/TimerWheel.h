@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace NatsMq
+{
+    //! Hashed timing wheel. One thread serves all timers, scheduling and cancelling are O(1).
+    //! Callbacks are invoked on the wheel thread, outside of the internal lock.
+    class TimerWheel
+    {
+    public:
+        using Callback = std::function<void()>;
+
+        TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(5), size_t slots = 512);
+
+        ~TimerWheel();
+
+        TimerWheel(const TimerWheel&) = delete;
+
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        //! Schedule callback after the delay. Returns timer id
+        uint64_t schedule(uint64_t delayMs, Callback cb);
+
+        //! Cancel timer. Returns false if the timer has already fired or been cancelled
+        bool cancel(uint64_t id);
+
+    private:
+        struct Timer
+        {
+            uint64_t rounds;
+            Callback callback;
+        };
+
+        void run();
+
+    private:
+        const std::chrono::milliseconds _tick;
+
+        std::mutex                          _mutex;
+        std::condition_variable             _cv;
+        std::vector<std::vector<uint64_t>>  _slots;
+        std::unordered_map<uint64_t, Timer> _timers;
+        size_t                              _current{ 0 };
+        uint64_t                            _nextId{ 1 };
+        bool                                _stopped{ false };
+        std::thread                         _thread;
+    };
+}
@@ -0,0 +1,75 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+using namespace NatsMq;
+
+WorkerPool::WorkerPool(int workers)
+{
+    const auto count = std::max(workers, 1);
+
+    _threads.reserve(count);
+    for (int i = 0; i < count; ++i)
+        _threads.emplace_back(&WorkerPool::run, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+bool WorkerPool::post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopped)
+            return false;
+
+        _tasks.push_back(std::move(task));
+    }
+
+    _cv.notify_one();
+    return true;
+}
+
+void WorkerPool::execute(Task task)
+{
+    post(std::move(task));
+}
+
+void WorkerPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+
+    _cv.notify_all();
+
+    for (auto&& thread : _threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+void WorkerPool::run()
+{
+    for (;;)
+    {
+        Task task;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return _stopped || !_tasks.empty(); });
+
+            if (_tasks.empty())
+                return;
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Executor.h"
+
+namespace NatsMq
+{
+    //! Fixed set of threads executing posted tasks in FIFO order
+    class WorkerPool : public Executor
+    {
+    public:
+        WorkerPool(int workers);
+
+        ~WorkerPool() override;
+
+        WorkerPool(const WorkerPool&) = delete;
+
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        //! Returns false if the pool is stopped, then the task is dropped
+        bool post(Task task);
+
+        void execute(Task task) override;
+
+        //! Execute the queued tasks and join the threads. Tasks posted after stop are dropped.
+        void stop();
+
+    private:
+        void run();
+
+    private:
+        std::mutex               _mutex;
+        std::condition_variable  _cv;
+        std::deque<Task>         _tasks;
+        bool                     _stopped{ false };
+        std::vector<std::thread> _threads;
+    };
+}
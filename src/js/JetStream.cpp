@@ -9,6 +9,7 @@
 #include "Stream.h"
 #include "Subscription.h"
 #include "SyncSubscription.h"
+#include "core/Connection.h"
 #include "js/Context.h"
 #include "js/KeyValueStorePrivate.h"
 #include "js/MessageManagerPrivate.h"
@@ -160,7 +161,7 @@ Js::Subscription* JetStream::subscribe(const std::string& subject, const std::st
 Js::Subscription* JetStream::subscribe(const std::string& subject, const Js::SubscriptionOptions& options, JsSubscriptionCb cb) const
 {
     auto impl = new Js::SubscriptionPrivate(_context->rawContext());
-    impl->registerListener(subject, options, std::move(cb));
+    impl->registerListener(subject, options, std::move(cb), _connection->errorSink());
     return new Js::Subscription(impl);
 }
 
@@ -7,23 +7,19 @@
 
 using namespace NatsMq;
 
-namespace
+Js::SubscriptionPrivate::SubscriptionPrivate(jsCtx* ctx)
+    : SubscriptionBaseTemplate(ctx)
 {
-    void subscriptionCallback(natsConnection* /*nc*/, natsSubscription* /*sub*/, natsMsg* msg, void* closure)
-    {
-        auto       cb   = reinterpret_cast<JsSubscriptionCb*>(closure);
-        const auto impl = new Js::IncomingMessagePrivate(msg);
-        (*cb)(Js::IncomingMessage(impl));
-    }
-
 }
 
-Js::SubscriptionPrivate::SubscriptionPrivate(jsCtx* ctx)
-    : SubscriptionBaseTemplate(ctx)
+Js::SubscriptionPrivate::~SubscriptionPrivate()
 {
+    // Stop feeding the delivery queue before it is destroyed, the deleter unsubscribes anyway
+    if (_delivery && _sub)
+        natsSubscription_Unsubscribe(_sub.get());
 }
 
-void Js::SubscriptionPrivate::registerListener(const std::string& subject, const SubscriptionOptions& options, JsSubscriptionCb cb)
+void Js::SubscriptionPrivate::registerListener(const std::string& subject, const SubscriptionOptions& options, JsSubscriptionCb cb, ErrorCb onError)
 {
     _cb = std::move(cb);
 
@@ -32,11 +28,42 @@ void Js::SubscriptionPrivate::registerListener(const std::string& subject, const
     natsSubscription* natsSub{ nullptr };
 
     jsErrCode  jerr;
-    const auto status = js_Subscribe(&natsSub, _ctx, subject.c_str(), &subscriptionCallback, &_cb, nullptr, &cnatsSubOptions, &jerr);
+    // The queue must exist before the first message is delivered
+    if (options.delivery.mode != DeliveryMode::Connection)
+    {
+        _deliveryCb = std::make_shared<JsSubscriptionCb>(_cb);
+        _key        = options.delivery.key;
+        _delivery   = std::make_unique<DeliveryQueue>(options.delivery, 0, subject, std::move(onError));
+    }
+
+    const auto status = js_Subscribe(&natsSub, _ctx, subject.c_str(), &subscriptionCallback, this, nullptr, &cnatsSubOptions, &jerr);
 
     jsExceptionIfError(status, jerr);
 
     _sub.reset(natsSub);
+
+    if (_delivery)
+        _delivery->setSubscriptionId(natsSubscription_GetID(natsSub));
+}
+
+void Js::SubscriptionPrivate::subscriptionCallback(natsConnection* /*nc*/, natsSubscription* /*sub*/, natsMsg* msg, void* closure)
+{
+    const auto sub = reinterpret_cast<Js::SubscriptionPrivate*>(closure);
+    sub->dataReady(msg);
+}
+
+void Js::SubscriptionPrivate::dataReady(natsMsg* msg)
+{
+    Js::IncomingMessage incoming(new Js::IncomingMessagePrivate(msg));
+
+    if (!_delivery)
+        return _cb(std::move(incoming));
+
+    const auto lane = _key ? _delivery->lane(_key(incoming.msg)) : 0;
+
+    // std::function requires a copyable callable, the message is move-only
+    auto shared = std::make_shared<Js::IncomingMessage>(std::move(incoming));
+    _delivery->post(lane, [cb = _deliveryCb, shared] { (*cb)(std::move(*shared)); });
 }
 
 void Js::SubscriptionPrivate::drain(int64_t timeoutMs)
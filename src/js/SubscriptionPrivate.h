@@ -2,7 +2,10 @@
 
 #include <nats.h>
 
+#include <memory>
+
 #include "Entities.h"
+#include "core/DeliveryQueue.h"
 #include "js/SubscriptionBaseTemplate.h"
 
 namespace NatsMq
@@ -14,14 +17,26 @@ namespace NatsMq
         public:
             SubscriptionPrivate(jsCtx* ctx);
 
-            void registerListener(const std::string& subject, const SubscriptionOptions& options, JsSubscriptionCb cb);
+            ~SubscriptionPrivate() override;
+
+            //! Exceptions thrown by queued callbacks are passed to onError
+            void registerListener(const std::string& subject, const SubscriptionOptions& options, JsSubscriptionCb cb, ErrorCb onError = {});
 
             void drain(int64_t timeoutMs);
 
             void waitDrain(int64_t timeoutMs = 0) const;
 
+        private:
+            static void subscriptionCallback(natsConnection* nc, natsSubscription* sub, natsMsg* msg, void* closure);
+
+            void dataReady(natsMsg* msg);
+
         private:
             JsSubscriptionCb _cb;
+
+            std::shared_ptr<JsSubscriptionCb> _deliveryCb;
+            std::unique_ptr<DeliveryQueue>    _delivery;
+            KeyExtractor                      _key;
         };
     }
 }
@@ -1,5 +1,6 @@
 #include "utils.h"
 
+#include <limits>
 #include <random>
 #include <sstream>
 
@@ -17,6 +18,7 @@ namespace
 
     NatsMq::Message::Headers parseHeaders(natsMsg* msg)
     {
+        // cnats parses the headers block only on the first header call, messages without headers return NATS_NOT_FOUND
         const char** keys{ nullptr };
         int          count;
 
@@ -27,9 +29,16 @@ namespace
         NatsMq::Message::Headers headers;
         for (auto i = 0; i < count; ++i)
         {
-            const char* value;
-            natsMsgHeader_Get(msg, keys[i], &value);
-            headers[keys[i]] = value;
+            const char** values{ nullptr };
+            int          valuesCount{ 0 };
+
+            if (natsMsgHeader_Values(msg, keys[i], &values, &valuesCount) != NATS_OK)
+                continue;
+
+            for (auto j = 0; j < valuesCount; ++j)
+                headers.add(keys[i], values[j]);
+
+            free((void*)values);
         }
 
         free((void*)keys);
@@ -52,8 +61,7 @@ NatsMq::NatsMsgPtr NatsMq::createCnatsMessage(const NatsMq::Message& msg)
 
     NatsMsgPtr natsMsg(cnatsMsg, &natsMsg_Destroy);
 
-    for (auto it = msg.headers.cbegin(), ite = msg.headers.cend(); it != ite; ++it)
-        exceptionIfError(natsMsgHeader_Add(cnatsMsg, it->first.c_str(), it->second.c_str()));
+    addCnatsHeaders(cnatsMsg, msg.headers);
 
     return natsMsg;
 }
@@ -85,7 +93,7 @@ bool NatsMq::makePing(natsConnection* connection, int timeout)
 void NatsMq::configurePoolSize(int poolSize)
 {
     if (poolSize > 1)
-        nats_SetMessageDeliveryPoolSize(poolSize);
+        exceptionIfError(nats_SetMessageDeliveryPoolSize(poolSize));
 }
 
 std::string NatsMq::emptyStringIfNull(const char* s)
@@ -93,6 +101,33 @@ std::string NatsMq::emptyStringIfNull(const char* s)
     return s ? s : "";
 }
 
+void NatsMq::addCnatsHeaders(natsMsg* msg, const Headers& headers)
+{
+    for (auto&& [key, value] : headers)
+    {
+        withCString(key, [msg, value = value](const char* k) {
+            withCString(value, [msg, k](const char* v) { exceptionIfError(natsMsgHeader_Add(msg, k, v)); });
+        });
+    }
+}
+
+std::string NatsMq::requestKey(const Message& msg)
+{
+    std::string key;
+    key.reserve(msg.subject.size() + 1 + msg.data.size());
+    key.append(msg.subject).push_back(' ');
+    key.append(msg.data.begin(), msg.data.end());
+    return key;
+}
+
+int NatsMq::checkedDataSize(size_t size)
+{
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max()))
+        exceptionIfError(Status::MaxPayload);
+
+    return static_cast<int>(size);
+}
+
 std::vector<const char*> NatsMq::createArrayPointersToElements(const std::vector<std::string>& elements)
 {
     std::vector<const char*> pointers;
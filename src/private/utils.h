@@ -2,7 +2,9 @@
 
 #include <nats.h>
 
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Entities.h"
@@ -11,6 +13,7 @@
 namespace NatsMq
 {
     struct Message;
+    class Headers;
 
     NatsMq::NatsMsgPtr createCnatsMessage(const Message& msg);
 
@@ -22,6 +25,33 @@ namespace NatsMq
 
     std::string emptyStringIfNull(const char* s);
 
+    //! Call func with a NULL terminated copy of the string. Short strings are copied to the stack, so no allocation occurs.
+    template <typename Func>
+    decltype(auto) withCString(std::string_view str, Func&& func)
+    {
+        constexpr size_t stackSize{ 256 };
+
+        if (str.size() < stackSize)
+        {
+            char buffer[stackSize];
+            std::memcpy(buffer, str.data(), str.size());
+            buffer[str.size()] = '\0';
+            return func(static_cast<const char*>(buffer));
+        }
+
+        const std::string copy(str);
+        return func(copy.c_str());
+    }
+
+    //! Check that the payload fits into cnats int size argument
+    int checkedDataSize(size_t size);
+
+    //! Add headers to cnats message. Keys and values are NULL terminated on the stack
+    void addCnatsHeaders(natsMsg* msg, const Headers& headers);
+
+    //! Identity of a request: subject and payload separated by a space (a subject can't contain spaces)
+    std::string requestKey(const Message& msg);
+
     std::vector<const char*> createArrayPointersToElements(const std::vector<std::string>& elements);
 
     natsMetadata toNatsMetadata(std::vector<const char*>& data);
@@ -1,7 +1,13 @@
 #include <Client.h>
+#include <ClientPool.h>
+#include <ConnectionProfiles.h>
 #include <Exceptions.h>
 #include <Message.h>
+#include <atomic>
+#include <chrono>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
 
 #include "preferences.h"
 #include "utilitys.h"
@@ -76,6 +82,168 @@ TEST(NatsMqClientTesting, attempt_publish)
     client->publish(msgFromString("test", "test one two"));
 }
 
+TEST(NatsMqClientTesting, publish_raw_bytes)
+{
+    constexpr auto subject{ "test_raw_publish" };
+    const std::string expectMsg{ "raw bytes" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::SyncSubscription> sub(client->syncSubscribe(subject));
+
+    client->publish(subject, expectMsg.data(), expectMsg.size());
+    client->publish(subject, NatsMq::ByteSpan{ reinterpret_cast<const uint8_t*>(expectMsg.data()), expectMsg.size() });
+
+    EXPECT_EQ(expectMsg, std::string(sub->next(1000)));
+    EXPECT_EQ(expectMsg, std::string(sub->next(1000)));
+}
+
+TEST(NatsMqClientTesting, publisher_handle)
+{
+    constexpr auto subject{ "test_handle" };
+    const std::string expectMsg{ "handle bytes" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    EXPECT_THROW({ std::unique_ptr<NatsMq::PublisherHandle>(client->publisher("invalid..subject")); }, NatsMq::Exception);
+
+    std::unique_ptr<NatsMq::SyncSubscription> sub(client->syncSubscribe("test_handle.>"));
+    std::unique_ptr<NatsMq::PublisherHandle>  handle(client->publisher(subject));
+
+    const NatsMq::ByteSpan data{ reinterpret_cast<const uint8_t*>(expectMsg.data()), expectMsg.size() };
+    handle->publish("device1", data);
+
+    const auto msg = sub->next(1000);
+    EXPECT_EQ("test_handle.device1", msg.subject);
+    EXPECT_EQ(expectMsg, std::string(msg));
+}
+
+TEST(NatsMqClientTesting, publish_batch)
+{
+    constexpr auto subject{ "test_batch" };
+    constexpr auto batchSize{ 100 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::SyncSubscription> sub(client->syncSubscribe(subject));
+
+    std::vector<NatsMq::Message> msgs;
+    for (auto i = 0; i < batchSize; ++i)
+        msgs.push_back(msgFromString(subject, std::to_string(i)));
+
+    // cnats rejects only an empty subject on publish
+    msgs.push_back(msgFromString("", "data"));
+
+    const auto statuses = client->publishBatch(msgs);
+
+    ASSERT_EQ(msgs.size(), statuses.size());
+    EXPECT_EQ(NatsMq::Status::InvalidSubject, statuses.back());
+
+    for (auto i = 0; i < batchSize; ++i)
+    {
+        EXPECT_EQ(NatsMq::Status::Ok, statuses[i]);
+        EXPECT_EQ(std::to_string(i), std::string(sub->next(1000)));
+    }
+}
+
+TEST(NatsMqClientTesting, cork_uncork)
+{
+    constexpr auto subject{ "test_cork" };
+
+    NatsMq::ConnectionOptions options;
+    options.flushPolicy.maxBufferedBytes = 1024;
+    options.flushPolicy.maxDelayUs       = 500;
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl }, options);
+
+    std::unique_ptr<NatsMq::SyncSubscription> sub(client->syncSubscribe(subject));
+
+    client->cork();
+    client->publish(msgFromString(subject, "first"));
+    client->publish(msgFromString(subject, "second"));
+    client->flush();
+
+    EXPECT_THROW({ sub->next(200); }, NatsMq::Exception);
+
+    const auto statuses = client->uncork();
+    EXPECT_EQ(2, statuses.size());
+
+    EXPECT_EQ("first", std::string(sub->next(1000)));
+    EXPECT_EQ("second", std::string(sub->next(1000)));
+}
+
+TEST(NatsMqClientTesting, flush_policy)
+{
+    constexpr auto subject{ "test_flush_policy" };
+
+    NatsMq::ConnectionOptions options;
+    options.flushPolicy.maxBufferedBytes = 10;
+    options.flushPolicy.maxDelayUs       = 100000;
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl }, options);
+
+    std::unique_ptr<NatsMq::SyncSubscription> sub(client->syncSubscribe(subject));
+
+    // A message below the size trigger is sent after the delay
+    client->publish(msgFromString(subject, "first"));
+    EXPECT_EQ("first", std::string(sub->next(1000)));
+
+    // Reaching the size trigger sends the held messages right away
+    client->publish(msgFromString(subject, "second"));
+    client->publish(msgFromString(subject, "third"));
+    EXPECT_EQ("second", std::string(sub->next(50)));
+    EXPECT_EQ("third", std::string(sub->next(50)));
+
+    // Without the delay trigger the tail of a burst would never be sent
+    NatsMq::ConnectionOptions noDelay;
+    noDelay.flushPolicy.maxBufferedBytes = 10;
+
+    const auto other = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    EXPECT_THROW({ other->connect({ natsUrl }, noDelay); }, NatsMq::Exception);
+}
+
+TEST(NatsMqClientTesting, flush_policy_request_order)
+{
+    constexpr auto stateSubject{ "test_flush_order.state" };
+    constexpr auto requestSubject{ "test_flush_order.request" };
+
+    const auto responder = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    responder->connect({ natsUrl });
+
+    // One subscription delivers both subjects in the order the server received them
+    std::atomic<bool>                     stateSeen{ false };
+    std::unique_ptr<NatsMq::Subscription> sub(responder->subscribe("test_flush_order.>", [&](NatsMq::Message msg) {
+        if (msg.subject == stateSubject)
+            stateSeen = true;
+        else
+            responder->publish(msgFromString(msg.replySubject, stateSeen ? "after" : "before"));
+    }));
+    responder->flush();
+
+    NatsMq::ConnectionOptions options;
+    options.flushPolicy.maxBufferedBytes = 1000;
+    options.flushPolicy.maxDelayUs       = 1000000;
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl }, options);
+
+    // The raw publish is held by the policy, the request must send it first
+    constexpr char state[]{ "state" };
+    client->publish(stateSubject, state, sizeof(state) - 1);
+    EXPECT_EQ("after", std::string(client->request(msgFromString(requestSubject, "get"), 1000)));
+
+    stateSeen = false;
+    client->publish(stateSubject, state, sizeof(state) - 1);
+    const auto replies = client->requestMany(msgFromString(requestSubject, "get"), 1, 1000);
+    ASSERT_EQ(1u, replies.size());
+    EXPECT_EQ("after", std::string(replies.front()));
+}
+
 TEST(NatsMqClientTesting, request_error)
 {
     auto cb = []() {
@@ -154,6 +322,436 @@ TEST(NatsMqClientTesting, async_request_with_responder)
     EXPECT_EQ(reply, std::string(expectMsg));
 }
 
+TEST(NatsMqClientTesting, async_requests_share_inbox)
+{
+    constexpr auto subject{ "test" };
+    constexpr auto requestsCount{ 16 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    auto replyCb = [&client](NatsMq::Message msg) {
+        NatsMq::Message reply(msg.replySubject, std::string(msg));
+        reply.headers.set("Id", msg.headers.get("Id"));
+        client->publish(std::move(reply));
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, std::move(replyCb)));
+
+    std::vector<std::future<NatsMq::Message>> futures;
+    for (auto i = 0; i < requestsCount; ++i)
+    {
+        NatsMq::Message msg(subject, std::to_string(i));
+        msg.headers.set("Id", std::to_string(i));
+        futures.push_back(client->arequest(std::move(msg), 2000));
+    }
+
+    for (auto i = 0; i < requestsCount; ++i)
+    {
+        const auto reply = futures[i].get();
+        EXPECT_EQ(std::to_string(i), std::string(reply));
+        EXPECT_EQ(std::to_string(i), reply.headers.get("Id"));
+    }
+}
+
+TEST(NatsMqClientTesting, callback_request_batch)
+{
+    constexpr auto subject{ "test" };
+    constexpr auto requestsCount{ 8 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    auto replyCb = [&client](NatsMq::Message msg) {
+        client->publish(NatsMq::Message(msg.replySubject, std::string(msg)));
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, std::move(replyCb)));
+
+    std::vector<NatsMq::Message> requests;
+    for (auto i = 0; i < requestsCount; ++i)
+        requests.emplace_back(subject, std::to_string(i));
+    requests.emplace_back("no_responders_subject", "");
+
+    std::promise<std::vector<NatsMq::Result<NatsMq::Message>>> promise;
+    client->requestBatch(std::move(requests), 2000, [&promise](auto results) { promise.set_value(std::move(results)); });
+
+    const auto results = promise.get_future().get();
+    ASSERT_EQ(results.size(), requestsCount + 1);
+
+    for (auto i = 0; i < requestsCount; ++i)
+        EXPECT_EQ(std::to_string(i), std::string(results[i].value()));
+
+    EXPECT_EQ(results.back().status(), NatsMq::Status::NoResponders);
+}
+
+TEST(NatsMqClientTesting, request_many)
+{
+    constexpr auto subject{ "test" };
+    constexpr auto respondersCount{ 3 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::vector<std::unique_ptr<NatsMq::Subscription>> responders;
+    for (auto i = 0; i < respondersCount; ++i)
+    {
+        auto replyCb = [&client, i](NatsMq::Message msg) {
+            client->publish(NatsMq::Message(msg.replySubject, std::to_string(i)));
+        };
+        responders.emplace_back(client->subscribe(subject, std::move(replyCb)));
+    }
+
+    const auto replies = client->requestMany(NatsMq::Message(subject, "ping"), 0, 500);
+    EXPECT_EQ(replies.size(), respondersCount);
+
+    size_t streamed{ 0 };
+    client->requestMany(NatsMq::Message(subject, "ping"), respondersCount, 2000, [&streamed](NatsMq::Message) {
+        return ++streamed < 2;
+    });
+    EXPECT_EQ(streamed, 2);
+
+    EXPECT_THROW(client->requestMany(NatsMq::Message("no_responders_subject", "ping"), 0, 500), NatsMq::Exception);
+}
+
+TEST(NatsMqClientTesting, hedged_request)
+{
+    constexpr auto subject{ "test" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    // The first copy of the request is lost, only the hedge copy is answered
+    std::atomic<int> received{ 0 };
+    auto             replyCb = [&client, &received](NatsMq::Message msg) {
+        if (received++ > 0)
+            client->publish(NatsMq::Message(msg.replySubject, "pong"));
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, std::move(replyCb)));
+
+    NatsMq::RequestPolicy policy;
+    policy.hedgeDelayMs = 50;
+
+    const auto reply = client->request(NatsMq::Message(subject, "ping"), 2000, policy);
+    EXPECT_EQ(std::string("pong"), std::string(reply));
+    EXPECT_EQ(received, 2);
+
+    policy.hedgeDelayMs = 0;
+    policy.maxRetries   = 2;
+    EXPECT_THROW(client->request(NatsMq::Message("no_responders_subject", "ping"), 500, policy), NatsMq::Exception);
+}
+
+TEST(NatsMqClientTesting, coalesced_requests)
+{
+    constexpr auto subject{ "test" };
+    constexpr auto requestsCount{ 8 };
+
+    NatsMq::ConnectionOptions options;
+    options.coalesceRequests = true;
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl }, options);
+
+    std::atomic<int> received{ 0 };
+    auto             replyCb = [&client, &received](NatsMq::Message msg) {
+        ++received;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        client->publish(NatsMq::Message(msg.replySubject, "pong"));
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, std::move(replyCb)));
+
+    std::vector<std::future<NatsMq::Message>> futures;
+    for (auto i = 0; i < requestsCount; ++i)
+        futures.push_back(client->arequest(NatsMq::Message(subject, "same question"), 2000));
+
+    for (auto&& future : futures)
+        EXPECT_EQ(std::string("pong"), std::string(future.get()));
+
+    EXPECT_EQ(received, 1);
+}
+
+TEST(NatsMqClientTesting, cached_requests)
+{
+    constexpr auto subject{ "test" };
+    constexpr auto invalidationSubject{ "test.invalidate" };
+
+    NatsMq::ConnectionOptions options;
+    options.replyCache.maxEntries          = 128;
+    options.replyCache.ttlMs               = 10000;
+    options.replyCache.invalidationSubject = invalidationSubject;
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl }, options);
+
+    std::atomic<int> received{ 0 };
+    auto             replyCb = [&client, &received](NatsMq::Message msg) {
+        ++received;
+        client->publish(NatsMq::Message(msg.replySubject, "pong"));
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, std::move(replyCb)));
+
+    EXPECT_EQ(std::string("pong"), std::string(client->request(NatsMq::Message(subject, "ping"))));
+    EXPECT_EQ(std::string("pong"), std::string(client->request(NatsMq::Message(subject, "ping"))));
+    EXPECT_EQ(received, 1);
+
+    client->publish(NatsMq::Message(invalidationSubject, subject));
+    client->flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(std::string("pong"), std::string(client->request(NatsMq::Message(subject, "ping"))));
+    EXPECT_EQ(received, 2);
+}
+
+TEST(NatsMqClientTesting, client_pool)
+{
+    constexpr auto connections{ 4 };
+    constexpr auto subjectsCount{ 16 };
+
+    const auto pool = std::unique_ptr<NatsMq::ClientPool>(NatsMq::ClientPool::create(connections));
+    pool->connect({ natsUrl });
+    ASSERT_EQ(pool->size(), connections);
+
+    std::atomic<int> received{ 0 };
+
+    std::unique_ptr<NatsMq::Subscription> sub(pool->subscribe("test_pool.>", [&received](NatsMq::Message) { ++received; }));
+    std::unique_ptr<NatsMq::Subscription> echo(pool->subscribe("test_pool_echo", [&pool](NatsMq::Message msg) {
+        pool->publish(NatsMq::Message(msg.replySubject, msg.data));
+    }));
+    pool->flush();
+
+    // Subjects are spread over connections, the subscription receives messages of all of them
+    for (auto i = 0; i < subjectsCount; ++i)
+        pool->publish(NatsMq::Message("test_pool." + std::to_string(i), "data"));
+    pool->flush();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (received < subjectsCount && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(received, subjectsCount);
+    EXPECT_EQ(&pool->clientFor("test_pool.1"), &pool->clientFor("test_pool.1"));
+    EXPECT_GE(pool->statistics().outMsgs, subjectsCount);
+
+    EXPECT_EQ(std::string("ping"), std::string(pool->request(NatsMq::Message("test_pool_echo", "ping"))));
+}
+
+TEST(NatsMqClientTesting, control_lane)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+
+    NatsMq::ConnectionOptions options;
+    options.controlLane.enabled  = true;
+    options.controlLane.subjects = { "test_health.>" };
+    client->connect({ natsUrl }, options);
+
+    const auto control = client->control();
+
+    std::unique_ptr<NatsMq::Subscription> health(client->subscribe("test_health.ping", [&control](NatsMq::Message msg) {
+        control.publish(NatsMq::Message(msg.replySubject, "pong"));
+    }));
+
+    const auto before = control.statistics();
+    EXPECT_EQ(std::string("pong"), std::string(client->request(NatsMq::Message("test_health.ping", "ping"))));
+
+    // The request, the subscription and the reply went through the control connection
+    const auto after = control.statistics();
+    EXPECT_GE(after.outMsgs - before.outMsgs, 2);
+    EXPECT_GE(after.inMsgs - before.inMsgs, 2);
+    EXPECT_EQ(client->statistics().outMsgs, 0);
+}
+
+TEST(NatsMqClientTesting, control_lane_batches)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+
+    NatsMq::ConnectionOptions options;
+    options.controlLane.enabled  = true;
+    options.controlLane.subjects = { "test_health.>" };
+    client->connect({ natsUrl }, options);
+
+    const auto control = client->control();
+
+    // Batches are split by subject between the connections
+    const auto statuses = client->publishBatch({ NatsMq::Message("test_health.state", "ok"), NatsMq::Message("test_bulk", "data") });
+    EXPECT_EQ(statuses, std::vector<NatsMq::Status>(2, NatsMq::Status::Ok));
+    EXPECT_EQ(control.statistics().outMsgs, 1);
+    EXPECT_EQ(client->statistics().outMsgs, 1);
+
+    std::unique_ptr<NatsMq::Subscription> health(client->subscribe("test_health.ping", [&control](NatsMq::Message msg) {
+        control.publish(NatsMq::Message(msg.replySubject, "pong"));
+    }));
+
+    std::promise<std::vector<NatsMq::Result<NatsMq::Message>>> promise;
+    client->requestBatch({ NatsMq::Message("test_bulk_nobody", "ping"), NatsMq::Message("test_health.ping", "ping") }, 1000,
+                         [&promise](std::vector<NatsMq::Result<NatsMq::Message>> results) { promise.set_value(std::move(results)); });
+
+    // Results keep the order of the requests
+    auto future = promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+
+    const auto results = future.get();
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].status(), NatsMq::Status::NoResponders);
+    ASSERT_TRUE(results[1].ok());
+    EXPECT_EQ(std::string(results[1].value()), "pong");
+}
+
+TEST(NatsMqClientTesting, control_lane_shares_callbacks)
+{
+    constexpr auto subject{ "test_health.slow" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+
+    NatsMq::ConnectionOptions options;
+    options.controlLane.enabled   = true;
+    options.controlLane.subjects  = { "test_health.>" };
+    options.maxPendingMessages    = 10;
+    options.errorReports.windowMs = 100;
+    client->connect({ natsUrl }, options);
+
+    std::mutex               mutex;
+    std::vector<std::string> subjects;
+
+    const auto handle = client->registerErrorReportCallback([&mutex, &subjects](const NatsMq::ErrorReport& report) {
+        std::lock_guard<std::mutex> lock(mutex);
+        subjects.push_back(report.subject);
+    });
+
+    // The subscription lives on the control connection
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, [](NatsMq::Message) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }));
+
+    for (int i = 0; i < 1000; ++i)
+        client->publish(NatsMq::Message(subject, "data"));
+    client->control().flush(1000);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!subjects.empty())
+            break;
+    }
+
+    sub.reset();
+    client->unregisterErrorReportCallback(handle);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_FALSE(subjects.empty());
+    EXPECT_EQ(subjects.front(), subject);
+}
+
+TEST(NatsMqClientTesting, connection_options_applied)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+
+    auto options                = NatsMq::ConnectionProfiles::lowLatency();
+    options.name                = "natsmq_tests";
+    options.disableNoResponders = true;
+    client->connect({ natsUrl }, options);
+
+    // Without the no responders feature the request waits for the timeout
+    try
+    {
+        client->request(NatsMq::Message("test_no_responders", "data"), 200);
+        GTEST_FAIL() << "Request without responders succeeded";
+    }
+    catch (const NatsMq::Exception& exc)
+    {
+        EXPECT_EQ(exc.status, NatsMq::Status::Timeout);
+    }
+}
+
+TEST(NatsMqClientTesting, callback_handles)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+
+    std::atomic<int> first{ 0 };
+    std::atomic<int> second{ 0 };
+    std::atomic<int> third{ 0 };
+
+    const auto firstHandle  = client->registerConnectionCallback([&first](NatsMq::ConnectionStatus) { ++first; });
+    const auto secondHandle = client->registerConnectionCallback([&second](NatsMq::ConnectionStatus) { ++second; });
+    const auto thirdHandle  = client->registerConnectionCallback([&third](NatsMq::ConnectionStatus) { ++third; });
+
+    // Removing a callback does not shift the handles of the others
+    client->unregisterConnectionCallback(firstHandle);
+    client->connect({ natsUrl });
+
+    EXPECT_EQ(first, 0);
+    EXPECT_GT(second, 0);
+    EXPECT_EQ(second, third);
+
+    client->unregisterConnectionCallback(thirdHandle);
+    client->disconnect();
+    client->connect({ natsUrl });
+
+    EXPECT_GT(second, third);
+    client->unregisterConnectionCallback(secondHandle);
+}
+
+TEST(NatsMqClientTesting, aggregated_error_reports)
+{
+    constexpr auto subject{ "test_slow_consumer" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+
+    NatsMq::ConnectionOptions options;
+    options.maxPendingMessages    = 10;
+    options.errorReports.windowMs = 100;
+    client->connect({ natsUrl }, options);
+
+    std::mutex                       mutex;
+    std::vector<NatsMq::ErrorReport> reports;
+    std::atomic<int>                 errors{ 0 };
+
+    const auto errorHandle  = client->registerErrorCallback([&errors](NatsMq::Status, const std::string&) { ++errors; });
+    const auto reportHandle = client->registerErrorReportCallback([&mutex, &reports](const NatsMq::ErrorReport& report) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back(report);
+    });
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, [](NatsMq::Message) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }));
+
+    for (int i = 0; i < 1000; ++i)
+        client->publish(NatsMq::Message(subject, "data"));
+    client->flush(1000);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!reports.empty())
+            break;
+    }
+
+    // Reports still collected are passed on disconnect, the callbacks must not outlive the locals
+    sub.reset();
+    client->unregisterErrorCallback(errorHandle);
+    client->unregisterErrorReportCallback(reportHandle);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_FALSE(reports.empty());
+
+    const auto& report = reports.front();
+    EXPECT_EQ(report.status, NatsMq::Status::SlowConsumer);
+    EXPECT_EQ(report.subject, subject);
+    EXPECT_NE(report.subscriptionId, 0);
+    EXPECT_GE(report.count, 1u);
+    EXPECT_GT(report.droppedMessages, 0);
+
+    // Error callbacks receive the aggregated reports instead of every single error
+    EXPECT_GE(errors, 1);
+}
+
 TEST(NatsMqClientTesting, reply)
 {
     constexpr auto expectMsgCb{ "test1" };
@@ -0,0 +1,68 @@
+#include <Client.h>
+#include <Exceptions.h>
+#include <Message.h>
+#include <Router.h>
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "preferences.h"
+#include "utilitys.h"
+
+using namespace Tests;
+
+TEST(NatsMqRouterTesting, dispatch_by_pattern)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::Router> router(client->router("router_test.>"));
+
+    std::mutex               m;
+    std::condition_variable  cv;
+    std::vector<std::string> exact;
+    std::vector<std::string> wildcard;
+
+    auto push = [&](std::vector<std::string>& to) {
+        return [&](NatsMq::Message msg) {
+            std::lock_guard<std::mutex> lock(m);
+            to.push_back(msg.subject);
+            cv.notify_all();
+        };
+    };
+
+    router->add("router_test.dev1.state", push(exact));
+    const auto id = router->add("router_test.*.state", push(wildcard));
+    EXPECT_EQ(router->size(), 2);
+
+    client->publish(NatsMq::Message("router_test.dev1.state", "on"));
+    client->publish(NatsMq::Message("router_test.dev2.state", "off"));
+    client->publish(NatsMq::Message("router_test.dev1.config", "{}"));
+
+    {
+        std::unique_lock<std::mutex> lc(m);
+        if (!cv.wait_for(lc, std::chrono::milliseconds(3000), [&] { return exact.size() == 1 && wildcard.size() == 2; }))
+            GTEST_FAIL() << "Router timeout";
+    }
+
+    EXPECT_EQ(exact[0], "router_test.dev1.state");
+    EXPECT_EQ(wildcard[1], "router_test.dev2.state");
+
+    router->remove(id);
+    EXPECT_EQ(router->size(), 1);
+
+    client->publish(NatsMq::Message("router_test.dev2.state", "on"));
+    client->flush();
+
+    // The config message and the one published after remove() match nothing
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (router->unmatched() < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    EXPECT_EQ(router->unmatched(), 2);
+    EXPECT_EQ(wildcard.size(), 2);
+
+    EXPECT_THROW(router->add("router_test..state", [](NatsMq::Message) {}), NatsMq::Exception);
+}
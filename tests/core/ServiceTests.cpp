@@ -0,0 +1,94 @@
+#include <Client.h>
+#include <Exceptions.h>
+#include <Message.h>
+#include <Service.h>
+#include <gtest/gtest.h>
+
+#include "preferences.h"
+#include "utilitys.h"
+
+using namespace Tests;
+
+namespace
+{
+    NatsMq::ServiceConfig serviceConfig()
+    {
+        NatsMq::ServiceConfig config;
+        config.name    = "test_service";
+        config.workers = 2;
+        return config;
+    }
+}
+
+TEST(NatsMqServiceTesting, endpoint_reply)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::Service> service(client->service(serviceConfig()));
+    service->addEndpoint("echo", [](NatsMq::Message msg) { return msg; }, "test.echo");
+
+    const auto reply = client->request(NatsMq::Message("test.echo", "data"));
+    EXPECT_EQ(std::string("data"), std::string(reply));
+
+    const auto stats = service->statistics();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].requests, 1);
+    EXPECT_EQ(stats[0].errors, 0);
+}
+
+TEST(NatsMqServiceTesting, endpoint_error)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::Service> service(client->service(serviceConfig()));
+    service->addEndpoint("fail", [](NatsMq::Message) -> NatsMq::Message { throw NatsMq::ServiceError(400, "bad request"); });
+
+    const auto reply = client->request(NatsMq::Message("fail", "data"));
+    EXPECT_EQ(reply.headers.get("Nats-Service-Error-Code"), "400");
+    EXPECT_EQ(reply.headers.get("Nats-Service-Error"), "bad request");
+
+    const auto stats = service->statistics();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].errors, 1);
+    EXPECT_EQ(stats[0].lastError, "bad request");
+}
+
+TEST(NatsMqServiceTesting, endpoint_unknown_exception)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::Service> service(client->service(serviceConfig()));
+    service->addEndpoint("fail", [](NatsMq::Message) -> NatsMq::Message { throw 42; });
+
+    const auto reply = client->request(NatsMq::Message("fail", "data"));
+    EXPECT_EQ(reply.headers.get("Nats-Service-Error-Code"), "500");
+
+    const auto stats = service->statistics();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].errors, 1);
+}
+
+TEST(NatsMqServiceTesting, discovery_ping)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::unique_ptr<NatsMq::Service> service(client->service(serviceConfig()));
+
+    const auto reply = client->request(NatsMq::Message("$SRV.PING.test_service." + service->id(), ""));
+    EXPECT_NE(std::string(reply).find(service->id()), std::string::npos);
+}
+
+TEST(NatsMqServiceTesting, invalid_name)
+{
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    auto config = serviceConfig();
+    config.name = "invalid name";
+
+    EXPECT_THROW(std::unique_ptr<NatsMq::Service>(client->service(config)), NatsMq::Exception);
+}
@@ -0,0 +1,56 @@
+#include <Exceptions.h>
+#include <Subject.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace NatsMq;
+
+static_assert(Subjects::isValid("telemetry.device.state"));
+static_assert(Subjects::token("telemetry.device.state", -1) == "state");
+
+TEST(NatsMqSubjectTesting, validation)
+{
+    EXPECT_TRUE(Subjects::isValid("a.b.c"));
+    EXPECT_FALSE(Subjects::isValid(""));
+    EXPECT_FALSE(Subjects::isValid("a..b"));
+    EXPECT_FALSE(Subjects::isValid("a.b."));
+    EXPECT_FALSE(Subjects::isValid("a b"));
+    EXPECT_FALSE(Subjects::isValid("a.*"));
+    EXPECT_TRUE(Subjects::isValid("a.*", true));
+    EXPECT_TRUE(Subjects::isValid("a.>", true));
+    EXPECT_FALSE(Subjects::isValid("a.>.b", true));
+
+    EXPECT_THROW(Subject("a..b"), Exception);
+    EXPECT_THROW(Subject("a.*"), Exception);
+    EXPECT_TRUE(Subject::pattern("a.*").isPattern());
+    EXPECT_FALSE(Subject::pattern("a.b").isPattern());
+}
+
+TEST(NatsMqSubjectTesting, tokens)
+{
+    std::vector<std::string_view> tokens;
+    for (auto token : Subjects::tokens("telemetry.device42.state"))
+        tokens.push_back(token);
+
+    const std::vector<std::string_view> expected{ "telemetry", "device42", "state" };
+    EXPECT_EQ(tokens, expected);
+
+    EXPECT_EQ(Subjects::tokenCount("telemetry.device42.state"), 3);
+    EXPECT_EQ(Subjects::token("telemetry.device42.state", 1), "device42");
+    EXPECT_EQ(Subjects::token("telemetry.device42.state", -3), "telemetry");
+    EXPECT_TRUE(Subjects::token("telemetry", 1).empty());
+}
+
+TEST(NatsMqSubjectTesting, matches)
+{
+    EXPECT_TRUE(Subjects::matches("a.b.c", "a.b.c"));
+    EXPECT_FALSE(Subjects::matches("a.b.c", "a.b"));
+    EXPECT_TRUE(Subjects::matches("a.*.c", "a.b.c"));
+    EXPECT_FALSE(Subjects::matches("a.*.c", "a.b.d"));
+    EXPECT_FALSE(Subjects::matches("a.*", "a.b.c"));
+    EXPECT_TRUE(Subjects::matches("a.>", "a.b.c"));
+    EXPECT_FALSE(Subjects::matches("a.>", "a"));
+    EXPECT_TRUE(Subjects::matches(">", "a"));
+    EXPECT_TRUE(Subject::pattern("*.state").matches("device.state"));
+}
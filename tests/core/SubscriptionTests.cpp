@@ -1,7 +1,13 @@
 #include <Client.h>
 #include <Exceptions.h>
+#include <KeyExtractors.h>
 #include <Message.h>
+#include <Runtime.h>
+#include <ThreadPoolExecutor.h>
+#include <atomic>
 #include <gtest/gtest.h>
+#include <map>
+#include <thread>
 
 #include <QDebug>
 
@@ -59,6 +65,40 @@ TEST(NatsMqSubscriptionTesting, sync_subscribe)
     EXPECT_EQ(reply, std::string(expectMsg));
 }
 
+TEST(NatsMqSubscriptionTesting, sync_next_batch)
+{
+    constexpr auto subject{ "testsub_sync_batch" };
+    constexpr auto messagesCount{ 15 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+    std::unique_ptr<NatsMq::SyncSubscription> sub(client->syncSubscribe(subject));
+
+    for (auto i = 0; i < messagesCount; ++i)
+        client->publish(NatsMq::Message(subject, std::to_string(i)));
+    client->flush();
+
+    std::vector<NatsMq::Message> batch;
+
+    // Wait until everything is queued, the first call returns what is already there
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (sub->messageCount() < messagesCount && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_EQ(sub->nextBatch(10, 1000, batch), 10);
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(std::string(batch[i]), std::to_string(i));
+
+    const auto capacity = batch.capacity();
+
+    ASSERT_EQ(sub->nextBatch(10, 1000, batch), messagesCount - 10);
+    EXPECT_EQ(std::string(batch.front()), "10");
+    EXPECT_EQ(batch.capacity(), capacity);
+
+    EXPECT_EQ(sub->nextBatch(10, 100, batch), 0);
+    EXPECT_TRUE(batch.empty());
+}
+
 TEST(NatsMqSubscriptionTesting, headers)
 {
     constexpr auto subject{ "testsub" };
@@ -89,5 +129,273 @@ TEST(NatsMqSubscriptionTesting, headers)
         GTEST_FAIL() << "Subscription timeout";
 }
 
+TEST(NatsMqSubscriptionTesting, multi_value_headers)
+{
+    constexpr auto subject{ "testsub_multi_headers" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::mutex              m;
+    std::condition_variable cv;
+
+    auto cb = [&cv](NatsMq::Message msg) {
+        const auto values = msg.headers.values("Route");
+        EXPECT_EQ(2, values.size());
+        EXPECT_EQ("42", msg.headers.get("TRACE-ID"));
+        cv.notify_all();
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, std::move(cb)));
+
+    NatsMq::Message msg(subject, "Important subscription data");
+    msg.headers.add("trace-id", "42");
+    msg.headers.add("route", "a");
+    msg.headers.add("route", "b");
+    client->publish(std::move(msg));
+
+    std::unique_lock<std::mutex> lc(m);
+
+    const auto status = cv.wait_for(lc, std::chrono::milliseconds(3000));
+    if (status == std::cv_status::timeout)
+        GTEST_FAIL() << "Subscription timeout";
+}
+
+TEST(NatsMqSubscriptionTesting, subscribe_view)
+{
+    constexpr auto expectMsg{ "test_subscribe_view" };
+    constexpr auto subject{ "testsub_view" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::mutex              m;
+    std::condition_variable cv;
+
+    auto cb = [&expectMsg, &subject, &cv](const NatsMq::MessageView& msg) {
+        EXPECT_EQ(subject, msg.subject());
+        EXPECT_EQ(expectMsg, std::string_view(msg));
+        EXPECT_EQ("val1", msg.header("key1"));
+        EXPECT_TRUE(msg.header("unknown").empty());
+        cv.notify_all();
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribeView(subject, std::move(cb)));
+
+    NatsMq::Message msg(subject, expectMsg);
+    msg.headers = { { "key1", "val1" } };
+    client->publish(std::move(msg));
+
+    std::unique_lock<std::mutex> lc(m);
+
+    const auto status = cv.wait_for(lc, std::chrono::milliseconds(3000));
+    if (status == std::cv_status::timeout)
+        GTEST_FAIL() << "Subscription timeout";
+}
+
+TEST(NatsMqSubscriptionTesting, dedicated_delivery)
+{
+    constexpr auto subject{ "testsub_dedicated" };
+    constexpr auto messagesCount{ 100 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::mutex              m;
+    std::condition_variable cv;
+    std::vector<int>        received;
+
+    auto cb = [&](NatsMq::Message msg) {
+        std::lock_guard<std::mutex> lock(m);
+        received.push_back(std::stoi(std::string(msg)));
+        cv.notify_all();
+    };
+
+    NatsMq::DeliveryOptions delivery;
+    delivery.mode = NatsMq::DeliveryMode::Dedicated;
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, "", delivery, std::move(cb)));
+
+    const auto stats = NatsMq::Runtime::deliveryStatistics();
+    const auto found = std::any_of(stats.begin(), stats.end(), [&sub](auto&& s) { return s.subscriptionId == sub->id(); });
+    EXPECT_TRUE(found);
+
+    for (auto i = 0; i < messagesCount; ++i)
+        client->publish(NatsMq::Message(subject, std::to_string(i)));
+
+    std::unique_lock<std::mutex> lc(m);
+    if (!cv.wait_for(lc, std::chrono::milliseconds(3000), [&received] { return received.size() == messagesCount; }))
+        GTEST_FAIL() << "Subscription timeout";
+
+    for (auto i = 0; i < messagesCount; ++i)
+        EXPECT_EQ(received[i], i);
+}
+
+TEST(NatsMqSubscriptionTesting, dedicated_delivery_callback_throws)
+{
+    constexpr auto subject{ "testsub_dedicated_throws" };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::atomic<int> errors{ 0 };
+    const auto       errorHandle = client->registerErrorCallback([&errors](NatsMq::Status, const std::string&) { ++errors; });
+
+    std::mutex               m;
+    std::condition_variable  cv;
+    std::vector<std::string> received;
+
+    auto cb = [&](NatsMq::Message msg) {
+        if (std::string(msg) == "throw")
+            throw std::runtime_error("callback failure");
+
+        std::lock_guard<std::mutex> lock(m);
+        received.push_back(std::string(msg));
+        cv.notify_all();
+    };
+
+    NatsMq::DeliveryOptions delivery;
+    delivery.mode = NatsMq::DeliveryMode::Dedicated;
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, "", delivery, std::move(cb)));
+
+    client->publish(NatsMq::Message(subject, "throw"));
+    client->publish(NatsMq::Message(subject, "next"));
+
+    // The exception is reported, the delivery goes on
+    {
+        std::unique_lock<std::mutex> lc(m);
+        if (!cv.wait_for(lc, std::chrono::milliseconds(3000), [&received] { return !received.empty(); }))
+            GTEST_FAIL() << "Subscription timeout";
+
+        EXPECT_EQ(received.front(), "next");
+    }
+
+    EXPECT_EQ(errors, 1);
+    client->unregisterErrorCallback(errorHandle);
+}
+
+TEST(NatsMqSubscriptionTesting, executor_delivery)
+{
+    constexpr auto subject{ "testsub_executor" };
+    constexpr auto messagesCount{ 100 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::mutex              m;
+    std::condition_variable cv;
+    std::vector<int>        received;
+
+    auto cb = [&](NatsMq::Message msg) {
+        std::lock_guard<std::mutex> lock(m);
+        received.push_back(std::stoi(std::string(msg)));
+        cv.notify_all();
+    };
+
+    auto executor = std::make_shared<NatsMq::ThreadPoolExecutor>(4);
+
+    NatsMq::DeliveryOptions delivery;
+    delivery.mode     = NatsMq::DeliveryMode::Executor;
+    delivery.executor = executor;
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(subject, "", delivery, std::move(cb)));
+
+    for (auto i = 0; i < messagesCount; ++i)
+        client->publish(NatsMq::Message(subject, std::to_string(i)));
+
+    std::unique_lock<std::mutex> lc(m);
+    if (!cv.wait_for(lc, std::chrono::milliseconds(3000), [&received] { return received.size() == messagesCount; }))
+        GTEST_FAIL() << "Subscription timeout";
+
+    // The executor has several threads, but callbacks of one subscription are still ordered
+    for (auto i = 0; i < messagesCount; ++i)
+        EXPECT_EQ(received[i], i);
+}
+
+TEST(NatsMqSubscriptionTesting, key_ordered_delivery)
+{
+    constexpr auto subject{ "testsub_keyordered" };
+    constexpr auto keysCount{ 4 };
+    constexpr auto messagesCount{ 50 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::mutex                              m;
+    std::condition_variable                 cv;
+    std::map<std::string, std::vector<int>> received;
+    int                                     total{ 0 };
+
+    auto cb = [&](NatsMq::Message msg) {
+        std::lock_guard<std::mutex> lock(m);
+        received[msg.subject].push_back(std::stoi(std::string(msg)));
+        ++total;
+        cv.notify_all();
+    };
+
+    NatsMq::DeliveryOptions delivery;
+    delivery.mode  = NatsMq::DeliveryMode::KeyOrdered;
+    delivery.key   = NatsMq::KeyExtractors::subjectToken(-1);
+    delivery.lanes = 3;
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribe(std::string(subject) + ".*", "", delivery, std::move(cb)));
+
+    for (auto i = 0; i < messagesCount; ++i)
+        for (auto k = 0; k < keysCount; ++k)
+            client->publish(NatsMq::Message(std::string(subject) + "." + std::to_string(k), std::to_string(i)));
+
+    std::unique_lock<std::mutex> lc(m);
+    if (!cv.wait_for(lc, std::chrono::milliseconds(3000), [&total] { return total == keysCount * messagesCount; }))
+        GTEST_FAIL() << "Subscription timeout";
+
+    // Lanes run in parallel, but messages of one key keep the publishing order
+    ASSERT_EQ(received.size(), keysCount);
+    for (auto&& [key, values] : received)
+        for (auto i = 0; i < messagesCount; ++i)
+            EXPECT_EQ(values[i], i);
+}
+
+TEST(NatsMqSubscriptionTesting, batch_subscription)
+{
+    constexpr auto subject{ "testsub_batch" };
+    constexpr auto maxBatch{ 10 };
+    constexpr auto messagesCount{ 25 };
+
+    const auto client = std::unique_ptr<NatsMq::Client>(NatsMq::Client::create());
+    client->connect({ natsUrl });
+
+    std::mutex              m;
+    std::condition_variable cv;
+    std::vector<int>        received;
+    std::vector<size_t>     batches;
+
+    auto cb = [&](std::vector<NatsMq::Message>& batch) {
+        std::lock_guard<std::mutex> lock(m);
+        batches.push_back(batch.size());
+        for (auto&& msg : batch)
+            received.push_back(std::stoi(std::string(msg)));
+        cv.notify_all();
+    };
+
+    std::unique_ptr<NatsMq::Subscription> sub(client->subscribeBatch(subject, maxBatch, 100, std::move(cb)));
+
+    for (auto i = 0; i < messagesCount; ++i)
+        client->publish(NatsMq::Message(subject, std::to_string(i)));
+
+    // Two full batches, the rest is flushed by the latency
+    std::unique_lock<std::mutex> lc(m);
+    if (!cv.wait_for(lc, std::chrono::milliseconds(3000), [&received] { return received.size() == messagesCount; }))
+        GTEST_FAIL() << "Subscription timeout";
+
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_EQ(batches[0], maxBatch);
+    EXPECT_EQ(batches[1], maxBatch);
+    EXPECT_EQ(batches[2], messagesCount - 2 * maxBatch);
+
+    for (auto i = 0; i < messagesCount; ++i)
+        EXPECT_EQ(received[i], i);
+}
+
 // TODO
 // drain, messageCount, statistics